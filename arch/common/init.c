@@ -8,6 +8,7 @@
 #include <zephyr/sys/util_macro.h>
 #include <zephyr/linker/section_tags.h>
 #include <zephyr/linker/linker-defs.h>
+#include <zephyr/profiling/boot_profile.h>
 
 /* LCOV_EXCL_START
  *
@@ -50,10 +51,13 @@ void __weak arch_early_memcpy(void *dst, const void *src, size_t n)
 __boot_func
 void arch_bss_zero(void)
 {
+	uint32_t start;
+
 	if (IS_ENABLED(CONFIG_SKIP_BSS_CLEAR)) {
 		return;
 	}
 
+	start = boot_profile_timestamp();
 	arch_early_memset(__bss_start, 0, __bss_end - __bss_start);
 #if DT_NODE_HAS_STATUS_OKAY(DT_CHOSEN(zephyr_dtcm))
 	arch_early_memset(&__dtcm_bss_start, 0,
@@ -78,6 +82,8 @@ void arch_bss_zero(void)
 	arch_early_memset(&_nocache_ram_start, 0,
 			(uintptr_t) &_nocache_ram_end - (uintptr_t) &_nocache_ram_start);
 #endif
+	/* Only recorded now that the BSS holding the records is cleared */
+	boot_profile_phase_record(BOOT_PROFILE_PHASE_BSS_ZERO, start);
 }
 
 #ifdef CONFIG_LINKER_USE_BOOT_SECTION
@@ -10,6 +10,7 @@
 #include <kernel_internal.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/arch/common/init.h>
+#include <zephyr/profiling/boot_profile.h>
 
 #ifdef CONFIG_REQUIRES_STACK_CANARIES
 #ifdef CONFIG_STACK_CANARIES_TLS
@@ -26,6 +27,8 @@ extern volatile uintptr_t __stack_chk_guard;
  */
 void arch_data_copy(void)
 {
+	uint32_t start = boot_profile_timestamp();
+
 	arch_early_memcpy(&__data_region_start, &__data_region_load_start,
 		       __data_region_end - __data_region_start);
 #ifdef CONFIG_ARCH_HAS_RAMFUNC_SUPPORT
@@ -75,4 +78,5 @@ void arch_data_copy(void)
 		       _app_smem_end - _app_smem_start);
 #endif /* CONFIG_REQUIRES_STACK_CANARIES */
 #endif /* CONFIG_USERSPACE */
+	boot_profile_phase_record(BOOT_PROFILE_PHASE_DATA_COPY, start);
 }
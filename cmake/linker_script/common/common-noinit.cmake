@@ -4,6 +4,13 @@
 
 zephyr_linker_section(NAME .noinit GROUP NOINIT_REGION TYPE NOLOAD NOINIT)
 
+if(CONFIG_LAZY_BSS)
+  zephyr_linker_section_configure(
+    SECTION .noinit
+    INPUT ".lazy_bss.*"
+    SYMBOLS __lazy_bss_start __lazy_bss_end)
+endif()
+
 if(CONFIG_USERSPACE)
   zephyr_linker_section_configure(
     SECTION .noinit
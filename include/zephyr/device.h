@@ -469,6 +469,21 @@ struct device_state {
 	 * invoked.
 	 */
 	bool initialized : 1;
+
+#if defined(CONFIG_DEVICE_INIT_PARALLEL) || defined(__DOXYGEN__)
+	/** Device is waiting to be picked by a parallel initialization thread. */
+	bool init_queued : 1;
+
+	/** Device initialization by a parallel initialization thread has not
+	 * completed yet.
+	 */
+	bool init_pending : 1;
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
+#if defined(CONFIG_DEVICE_INIT_STATS) || defined(__DOXYGEN__)
+	/** Time spent in the device initialization function, in cycles. */
+	uint32_t init_cycles;
+#endif /* CONFIG_DEVICE_INIT_STATS */
 };
 
 struct pm_device_base;
@@ -905,6 +920,18 @@ __syscall int device_init(const struct device *dev);
  */
 __syscall int device_deinit(const struct device *dev);
 
+/**
+ * @brief Get the time spent initializing a device.
+ *
+ * Note: this will be available if CONFIG_DEVICE_INIT_STATS is enabled.
+ *
+ * @param dev device in question.
+ *
+ * @return Time spent in the initialization function of the device, in
+ * microseconds, or 0 if the device has not been initialized.
+ */
+uint32_t device_init_time_us(const struct device *dev);
+
 /**
  * @}
  */
@@ -1268,6 +1295,7 @@ device_get_dt_nodelabels(const struct device *dev)
 		Z_INIT_ENTRY_NAME(DEVICE_NAME_GET(dev_id)) = {                                     \
 			.init_fn = NULL,                                                           \
 			.dev = (const struct device *)&DEVICE_NAME_GET(dev_id),                    \
+			IF_ENABLED(CONFIG_PROFILING_BOOT, (.priority = prio,))                     \
 		}
 
 /**
@@ -74,6 +74,18 @@ struct init_entry {
 	 * reference to it, otherwise it is set to NULL.
 	 */
 	const struct device *dev;
+#if defined(CONFIG_PROFILING_BOOT) || defined(__DOXYGEN__)
+	/**
+	 * Name of the SYS_INIT function, NULL for devices. Only available if
+	 * @kconfig{CONFIG_PROFILING_BOOT} is enabled.
+	 */
+	const char *fn_name;
+	/**
+	 * Priority of the entry within its level. Only available if
+	 * @kconfig{CONFIG_PROFILING_BOOT} is enabled.
+	 */
+	uint16_t priority;
+#endif /* CONFIG_PROFILING_BOOT */
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -166,7 +178,12 @@ struct init_entry {
 #define SYS_INIT_NAMED(name, init_fn_, level, prio)                                       \
 	static const Z_DECL_ALIGN(struct init_entry)                                      \
 		Z_INIT_ENTRY_SECTION(level, prio, 0) __used __noasan                      \
-		Z_INIT_ENTRY_NAME(name) = {.init_fn = (init_fn_), .dev = NULL}            \
+		Z_INIT_ENTRY_NAME(name) = {                                               \
+			.init_fn = (init_fn_),                                            \
+			.dev = NULL,                                                      \
+			IF_ENABLED(CONFIG_PROFILING_BOOT,                                 \
+				   (.fn_name = STRINGIFY(init_fn_), .priority = prio,))   \
+		}
 
 /** @} */
 
@@ -2254,6 +2254,12 @@ struct k_queue {
 	sys_sflist_t data_q;
 	struct k_spinlock lock;
 	_wait_q_t wait_q;
+#ifdef CONFIG_QUEUE_MPSC
+	/* Items appended without the lock, most recent first */
+	atomic_ptr_t staged;
+	/* Threads and pollers that lock-free producers must wake up */
+	atomic_t waiters;
+#endif /* CONFIG_QUEUE_MPSC */
 
 	Z_DECL_POLL_EVENT
 
@@ -2492,6 +2498,11 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_MPSC
+	if (atomic_ptr_get(&queue->staged) != NULL) {
+		return 0;
+	}
+#endif /* CONFIG_QUEUE_MPSC */
 	return sys_sflist_is_empty(&queue->data_q) ? 1 : 0;
 }
 
@@ -3943,6 +3954,9 @@ int k_work_submit_to_queue(struct k_work_q *queue,
 			   struct k_work *work);
 
 /** @brief Submit a work item to the system queue.
+ *
+ * With CONFIG_SYSTEM_WORKQUEUE_PER_CPU the item is submitted to the system
+ * work queue of the CPU the caller is running on.
  *
  * @funcprops \isr_ok
  *
@@ -3952,6 +3966,43 @@ int k_work_submit_to_queue(struct k_work_q *queue,
  */
 int k_work_submit(struct k_work *work);
 
+/** @brief Submit several work items to a queue at once.
+ *
+ * Each item is submitted as with k_work_submit_to_queue(), but the whole
+ * batch is queued under a single acquisition of the work queue lock and
+ * the queue thread is woken at most once, which makes submitting bursts
+ * of items (e.g. from an interrupt handler) considerably cheaper.  Items
+ * are queued in array order.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the work queue on which the items should run.  If
+ * NULL the queue from the most recent submission of each item will be used.
+ *
+ * @param work array of pointers to the work items.
+ *
+ * @param count number of entries in @p work.
+ *
+ * @return the number of items that are on a queue after the call, i.e. for
+ * which k_work_submit_to_queue() would have returned a non-negative value.
+ * This is less than @p count if some submissions were rejected; the state of
+ * the individual items can be checked with k_work_busy_get().
+ */
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work *const *work, size_t count);
+
+/** @brief Submit several work items to the system queue at once.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param work array of pointers to the work items.
+ *
+ * @param count number of entries in @p work.
+ *
+ * @return as with k_work_submit_batch_to_queue().
+ */
+int k_work_submit_batch(struct k_work *const *work, size_t count);
+
 /** @brief Wait for last-submitted instance to complete.
  *
  * Resubmissions may occur while waiting, including chained submissions (from
@@ -4661,6 +4712,16 @@ struct k_work_queue_config {
 	 * an error will be logged if CONFIG_LOG is enabled.
 	 */
 	uint32_t work_timeout_ms;
+
+#if defined(CONFIG_SCHED_CPU_MASK) || defined(__DOXYGEN__)
+	/** Restrict the work queue thread to a set of CPUs.
+	 *
+	 * Bit N set allows the thread to run on CPU N.  If zero the
+	 * thread keeps the default CPU mask.  Only available with
+	 * CONFIG_SCHED_CPU_MASK.
+	 */
+	uint32_t cpu_mask;
+#endif
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -5088,6 +5149,20 @@ struct k_msgq {
 	char *write_ptr;
 	/** Number of used messages */
 	uint32_t used_msgs;
+#if defined(CONFIG_MSGQ_MPSC) || defined(__DOXYGEN__)
+	/** Slots not yet reserved by a producer */
+	atomic_t mpsc_free;
+	/** Number of published messages */
+	atomic_t mpsc_used;
+	/** Index of the next slot to reserve */
+	atomic_t mpsc_reserve;
+	/** Index of the next slot to publish */
+	atomic_t mpsc_commit;
+	/** Threads and pollers that producers must wake up */
+	atomic_t mpsc_waiters;
+	/** Producers waiting for a free slot, readers use wait_q */
+	_wait_q_t mpsc_put_wait_q;
+#endif
 
 	Z_DECL_POLL_EVENT
 
@@ -5105,6 +5180,14 @@ struct k_msgq {
  */
 
 
+#ifdef CONFIG_MSGQ_MPSC
+#define Z_MSGQ_MPSC_INIT(obj, q_max_msgs) \
+	.mpsc_free = ATOMIC_INIT(q_max_msgs), \
+	.mpsc_put_wait_q = Z_WAIT_Q_INIT(&obj.mpsc_put_wait_q),
+#else
+#define Z_MSGQ_MPSC_INIT(obj, q_max_msgs)
+#endif /* CONFIG_MSGQ_MPSC */
+
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
@@ -5116,6 +5199,7 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	Z_MSGQ_MPSC_INIT(obj, q_max_msgs) \
 	Z_POLL_EVENT_OBJ_INIT(obj) \
 	.flags = 0, \
 	}
@@ -5357,7 +5441,11 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_MPSC
+	return msgq->max_msgs - (uint32_t)atomic_get(&msgq->mpsc_used);
+#else
 	return msgq->max_msgs - msgq->used_msgs;
+#endif /* CONFIG_MSGQ_MPSC */
 }
 
 /**
@@ -5373,7 +5461,11 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_MPSC
+	return (uint32_t)atomic_get(&msgq->mpsc_used);
+#else
 	return msgq->used_msgs;
+#endif /* CONFIG_MSGQ_MPSC */
 }
 
 /** @} */
@@ -5554,6 +5646,8 @@ __syscall void k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t buffer_s
 enum pipe_flags {
 	PIPE_FLAG_OPEN = BIT(0),
 	PIPE_FLAG_RESET = BIT(1),
+	PIPE_FLAG_WRITE_CLAIM = BIT(2),
+	PIPE_FLAG_READ_CLAIM = BIT(3),
 };
 
 struct k_pipe {
@@ -5620,6 +5714,7 @@ struct k_pipe {
  *
  * @retval number of bytes written on success
  * @retval -EAGAIN if no data could be written before the timeout expired
+ * @retval -EBUSY if a write claim is outstanding, see k_pipe_write_claim(..)
  * @retval -ECANCELED if the write was interrupted by k_pipe_reset(..)
  * @retval -EPIPE if the pipe was closed
  */
@@ -5638,12 +5733,102 @@ __syscall int k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len,
  *
  * @retval number of bytes read on success
  * @retval -EAGAIN if no data could be read before the timeout expired
+ * @retval -EBUSY if a read claim is outstanding, see k_pipe_read_claim(..)
  * @retval -ECANCELED if the read was interrupted by k_pipe_reset(..)
  * @retval -EPIPE if the pipe was closed
  */
 __syscall int k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len,
 			  k_timeout_t timeout);
 
+/**
+ * @brief Claim space in a pipe to write data in place
+ *
+ * This routine hands out a contiguous area of the pipe's ring buffer, of up
+ * to @a len bytes, that the caller fills directly instead of passing a copy to
+ * k_pipe_write(..). The data becomes visible to readers once it is committed
+ * with k_pipe_write_commit(..). If the pipe is full, the routine blocks until
+ * some space is freed or the timeout expires.
+ *
+ * Only one write claim can be outstanding at a time, and k_pipe_write(..)
+ * fails with -EBUSY until it is committed, also in the threads that were
+ * already waiting for space. The area may be shorter than
+ * requested when the ring buffer wraps around.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed area.
+ * @param len Requested number of bytes.
+ * @param timeout Waiting period to wait for space to be available.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EAGAIN if no space was available before the timeout expired
+ * @retval -EBUSY if a write claim is already outstanding
+ * @retval -ECANCELED if the claim was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed
+ */
+__syscall int k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+				 k_timeout_t timeout);
+
+/**
+ * @brief Commit data written in place to a pipe
+ *
+ * This routine makes the first @a len bytes of the area returned by
+ * k_pipe_write_claim(..) available to readers, and wakes up the readers
+ * waiting for data. The rest of the claimed area is returned to the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes written, up to the claimed size.
+ *
+ * @retval number of bytes committed on success
+ * @retval -EINVAL if @a len exceeds the claim, or no claim is outstanding,
+ *         e.g. because the pipe was reset
+ * @retval -EPIPE if the pipe was closed, the data is discarded
+ */
+__syscall int k_pipe_write_commit(struct k_pipe *pipe, size_t len);
+
+/**
+ * @brief Claim data in a pipe to read it in place
+ *
+ * This routine hands out a contiguous area of up to @a len bytes of unread
+ * data from the pipe's ring buffer, that the caller consumes directly instead
+ * of having it copied by k_pipe_read(..). The data is released with
+ * k_pipe_read_finish(..). If the pipe is empty, the routine blocks until some
+ * data is written or the timeout expires.
+ *
+ * Only one read claim can be outstanding at a time, and k_pipe_read(..)
+ * fails with -EBUSY until it is finished, also in the threads that were
+ * already waiting for data. The area may be shorter than
+ * the available data when the ring buffer wraps around.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed data.
+ * @param len Maximum number of bytes to claim.
+ * @param timeout Waiting period to wait for data to be available.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EAGAIN if no data was available before the timeout expired
+ * @retval -EBUSY if a read claim is already outstanding
+ * @retval -ECANCELED if the claim was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed and is empty
+ */
+__syscall int k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+				k_timeout_t timeout);
+
+/**
+ * @brief Release data read in place from a pipe
+ *
+ * This routine frees the first @a len bytes of the area returned by
+ * k_pipe_read_claim(..), and wakes up the writers waiting for space. The rest
+ * of the claimed data stays in the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes consumed, up to the claimed size.
+ *
+ * @retval number of bytes released on success
+ * @retval -EINVAL if @a len exceeds the claim, or no claim is outstanding,
+ *         e.g. because the pipe was reset
+ */
+__syscall int k_pipe_read_finish(struct k_pipe *pipe, size_t len);
+
 /**
  * @brief Reset a pipe
  * This routine resets the pipe, discarding any unread data and unblocking any threads waiting to
@@ -5676,7 +5861,23 @@ struct k_mem_slab_info {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Only filled in by the obj_core raw stats */
+	uint32_t num_cached;
+	uint32_t cache_hits;
+	uint32_t cache_misses;
+#endif
+};
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	uint32_t hits;
+	uint32_t misses;
+	void *blocks[CONFIG_MEM_SLAB_CPU_CACHE_SIZE];
 };
+#endif
 
 struct k_mem_slab {
 	_wait_q_t wait_q;
@@ -5685,6 +5886,12 @@ struct k_mem_slab {
 	char *free_list;
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* info.num_used also counts the blocks held in these */
+	struct k_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+	atomic_t cpu_cache_waiters;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5702,6 +5909,10 @@ struct k_mem_slab {
 	.info = {_slab_num_blocks, _slab_block_size, 0}               \
 	}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab);
+#endif
+
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -5896,7 +6107,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return z_mem_slab_num_used_get(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5935,7 +6150,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -6378,6 +6593,12 @@ enum k_poll_modes {
 	/* polling thread does not take ownership of objects when available */
 	K_POLL_MODE_NOTIFY_ONLY = 0,
 
+	/*
+	 * as K_POLL_MODE_NOTIFY_ONLY, and in a poll set, only report the
+	 * event again when its object is signaled again
+	 */
+	K_POLL_MODE_EDGE_TRIGGERED,
+
 	K_POLL_NUM_MODES
 };
 
@@ -6489,7 +6710,9 @@ struct k_poll_event {
  *             values. Only values that apply to the same object being polled
  *             can be used together. Choosing K_POLL_TYPE_IGNORE disables the
  *             event.
- * @param mode Future. Use K_POLL_MODE_NOTIFY_ONLY.
+ * @param mode K_POLL_MODE_NOTIFY_ONLY, or K_POLL_MODE_EDGE_TRIGGERED for an
+ *             event added to a poll set with k_poll_set_add(). k_poll()
+ *             handles both modes the same way.
  * @param obj Kernel object or poll signal.
  */
 
@@ -6515,7 +6738,9 @@ void k_poll_event_init(struct k_poll_event *event, uint32_t type,
  *
  * When k_poll() returns 0, the caller should loop on all the events that were
  * passed to k_poll() and check the state field for the values that were
- * expected and take the associated actions.
+ * expected and take the associated actions. All the events whose condition is
+ * met when the polling thread wakes up are reported, not only the one that
+ * woke it up.
  *
  * Before being reused for another call to k_poll(), the user has to reset the
  * state field to K_POLL_STATE_NOT_READY.
@@ -6576,8 +6801,8 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
  * @brief Signal a poll signal object.
  *
  * This routine makes ready a poll signal, which is basically a poll event of
- * type K_POLL_TYPE_SIGNAL. If a thread was polling on that event, it will be
- * made ready to run. A @a result value can be specified.
+ * type K_POLL_TYPE_SIGNAL. All the threads polling on that event are made
+ * ready to run, with a single reschedule. A @a result value can be specified.
  *
  * The poll signal contains a 'signaled' field that, when set by
  * k_poll_signal_raise(), stays set until the user sets it back to 0 with
@@ -6598,6 +6823,86 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A poll set keeps a persistent collection of poll events registered on
+ * their objects, and queues the ones that fire on an internal ready list.
+ * Waiting on a poll set is therefore proportional to the number of ready
+ * events rather than to the number of events in the set.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t collected;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set The poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add a poll event to a poll set.
+ *
+ * The event, initialized with k_poll_event_init(), stays registered on its
+ * object until it is removed with k_poll_set_remove(). The event memory must
+ * remain valid for as long as it is part of the set.
+ *
+ * By default, poll sets are level-triggered: an event returned by
+ * k_poll_set_wait() is re-armed on the next call to k_poll_set_wait(), and is
+ * reported again if its condition still holds. An event initialized with
+ * K_POLL_MODE_EDGE_TRIGGERED is instead registered again on its object as soon
+ * as it is returned, without checking its condition, and is only reported
+ * again when its object is signaled again. Its owner must then handle
+ * everything available on the object before waiting again. The state field of
+ * an edge-triggered event is valid until its next report.
+ *
+ * @param set The poll set.
+ * @param event The event to add, which must not already belong to a set.
+ */
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove a poll event from a poll set.
+ *
+ * @param set The poll set.
+ * @param event The event to remove.
+ */
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to become ready.
+ *
+ * Only ready events are returned, in the order in which they fired; the
+ * state field of each returned event describes the condition that was met.
+ * Several threads may wait on the same set, each ready event is handed to a
+ * single one of them.
+ *
+ * @note Can only be called from a thread, and not from user mode.
+ *
+ * @param set The poll set.
+ * @param ready Array receiving pointers to the ready events.
+ * @param max Capacity of @a ready.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a ready, 0 if the waiting period
+ *         expired without any event becoming ready.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready, int max,
+		    k_timeout_t timeout);
+
 /** @} */
 
 /**
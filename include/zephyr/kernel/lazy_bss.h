@@ -0,0 +1,71 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Lazily cleared BSS
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_LAZY_BSS_H_
+#define ZEPHYR_INCLUDE_KERNEL_LAZY_BSS_H_
+
+#include <stddef.h>
+
+#include <zephyr/linker/section_tags.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup lazy_bss Lazily cleared BSS
+ * @ingroup kernel_apis
+ *
+ * Zero-initialized objects tagged with @c __lazy_bss are not cleared at boot
+ * along with the rest of the BSS, but in the background by the idle thread.
+ * Their owner must call lazy_bss_ensure() before first accessing them, which
+ * completes the clearing synchronously if the idle thread did not get to it
+ * yet.
+ *
+ * Without @kconfig{CONFIG_LAZY_BSS}, @c __lazy_bss objects are regular BSS
+ * objects and lazy_bss_ensure() does nothing.
+ *
+ * @{
+ */
+
+#if defined(CONFIG_LAZY_BSS) || defined(__DOXYGEN__)
+
+/**
+ * @brief Make sure a lazily cleared object is zeroed
+ *
+ * Must be called before the first access to an object tagged with
+ * @c __lazy_bss, from a context that may take a spinlock. The clearing is done
+ * in chunks of @kconfig{CONFIG_LAZY_BSS_CHUNK_SIZE} bytes, and may include
+ * objects placed before @p obj.
+ *
+ * @param obj Lazily cleared object.
+ * @param size Size of the object, in bytes.
+ */
+void lazy_bss_ensure(const void *obj, size_t size);
+
+#else
+
+static inline void lazy_bss_ensure(const void *obj, size_t size)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(size);
+}
+
+#endif /* CONFIG_LAZY_BSS */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_LAZY_BSS_H_ */
@@ -50,6 +50,9 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif /* !CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+		/** Number of data pages loaded ahead of a page fault */
+		unsigned long			prefetched;
 	} pagefaults;
 
 	struct {
@@ -59,6 +62,41 @@ struct k_mem_paging_stats_t {
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
 	} eviction;
+
+#if defined(CONFIG_DEMAND_PAGING_REFAULT_STATS) || defined(__DOXYGEN__)
+	struct {
+		/** Number of page faults loading back a recently evicted page */
+		unsigned long			cnt;
+
+		/**
+		 * Refault distance histogram: number of evictions between
+		 * the eviction of a data page and its refault. The first bin
+		 * counts a distance of 0, bin i counts distances from 2^(i-1)
+		 * to 2^i - 1, the last bin also counts larger distances.
+		 */
+		unsigned long
+			distance[CONFIG_DEMAND_PAGING_REFAULT_HISTOGRAM_NUM_BINS];
+	} refaults;
+#endif /* CONFIG_DEMAND_PAGING_REFAULT_STATS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+};
+
+/**
+ * Backing Store Statistics.
+ */
+struct k_mem_paging_backing_store_stats_t {
+#if defined(CONFIG_DEMAND_PAGING_STATS) || defined(__DOXYGEN__)
+	/** Number of data pages held by the backing store */
+	unsigned long			pages;
+
+	/** Number of data pages held without compression */
+	unsigned long			incompressible;
+
+	/** Size of the data pages held, in bytes */
+	size_t				orig_bytes;
+
+	/** Storage used to hold the data pages, in bytes */
+	size_t				stored_bytes;
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
@@ -205,6 +243,32 @@ __syscall void k_mem_paging_histogram_backing_store_page_in_get(
 __syscall void k_mem_paging_histogram_backing_store_page_out_get(
 	struct k_mem_paging_histogram_t *hist);
 
+/**
+ * Get the page fault timing histogram
+ *
+ * This populates the timing histogram struct being passed in
+ * as argument. It covers the handling of page faults loading a data page,
+ * from the selection of a page frame to the mapping of the data page, and
+ * uses the same bounds as the backing store histograms.
+ *
+ * @param[in,out] hist Timing histogram struct to be filled.
+ */
+__syscall void k_mem_paging_histogram_page_fault_get(
+	struct k_mem_paging_histogram_t *hist);
+
+/**
+ * Get the backing store statistics
+ *
+ * This populates the backing store statistics struct being passed in
+ * as argument, with the values reported by
+ * k_mem_paging_backing_store_stats(). The compression ratio of a
+ * compressing backing store is orig_bytes / stored_bytes.
+ *
+ * @param[in,out] stats Backing store statistics struct to be filled.
+ */
+__syscall void k_mem_paging_backing_store_stats_get(
+	struct k_mem_paging_backing_store_stats_t *stats);
+
 #include <zephyr/syscalls/demand_paging.h>
 
 /** @} */
@@ -450,6 +514,17 @@ void k_mem_paging_backing_store_page_finalize(struct k_mem_page_frame *pf,
  */
 void k_mem_paging_backing_store_init(void);
 
+/**
+ * Report backing store statistics
+ *
+ * Called by k_mem_paging_backing_store_stats_get() when
+ * CONFIG_DEMAND_PAGING_STATS is enabled. The default implementation reports
+ * no data page, backing stores keeping track of their usage can override it.
+ *
+ * @param [out] stats Backing store statistics, zeroed by the caller
+ */
+void k_mem_paging_backing_store_stats(struct k_mem_paging_backing_store_stats_t *stats);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -0,0 +1,99 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Batched system calls
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_SYSCALL_BATCH_H_
+#define ZEPHYR_INCLUDE_KERNEL_SYSCALL_BATCH_H_
+
+#ifndef _ASMLANGUAGE
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup syscall_batch_apis Batched System Call APIs
+ * @ingroup kernel_apis
+ *
+ * A batch is an array of kernel operations submitted to the kernel at once
+ * with k_syscall_batch(). User threads pay the cost of entering and leaving
+ * the kernel once per batch rather than once per operation.
+ *
+ * @{
+ */
+
+/** Operations of a batch entry */
+enum k_syscall_batch_op {
+	/** k_sem_give() on @c obj */
+	K_SYSCALL_BATCH_SEM_GIVE,
+	/** k_sem_take() on @c obj with @c timeout */
+	K_SYSCALL_BATCH_SEM_TAKE,
+	/** k_msgq_put() of @c data on @c obj with @c timeout */
+	K_SYSCALL_BATCH_MSGQ_PUT,
+	/** k_msgq_get() to @c data from @c obj with @c timeout */
+	K_SYSCALL_BATCH_MSGQ_GET,
+	/** k_event_post() of @c value on @c obj, previous events to @c value */
+	K_SYSCALL_BATCH_EVENT_POST,
+	/** k_event_set() of @c value on @c obj, previous events to @c value */
+	K_SYSCALL_BATCH_EVENT_SET,
+	/** k_poll_signal_raise() on @c obj with @c value as result */
+	K_SYSCALL_BATCH_POLL_SIGNAL_RAISE,
+};
+
+/**
+ * @brief Batch entry
+ *
+ * Fields which are not used by the operation are ignored.
+ */
+struct k_syscall_batch_entry {
+	/** Operation, see @ref k_syscall_batch_op */
+	uint32_t op;
+	/** Return value of the operation, set by k_syscall_batch() */
+	int32_t result;
+	/** Kernel object the operation applies to */
+	void *obj;
+	/** Message buffer */
+	void *data;
+	/** Events or poll signal result */
+	uint32_t value;
+	/** Waiting period of blocking operations */
+	k_timeout_t timeout;
+};
+
+/**
+ * @brief Run a batch of kernel operations
+ *
+ * Runs the operations of @p entries in order, each one as if it had been
+ * called on its own, and sets their @c result. A failed operation does not
+ * stop the batch, and unknown operations fail with -EINVAL. From user mode,
+ * invalid kernel objects or buffers generate a kernel oops as they would with
+ * the corresponding system call.
+ *
+ * Blocking operations block the whole batch. The kernel object permissions
+ * are checked for every operation, right before running it.
+ *
+ * @param entries Batch entries.
+ * @param num Number of batch entries.
+ *
+ * @return Number of entries whose result is not zero.
+ */
+__syscall int k_syscall_batch(struct k_syscall_batch_entry *entries, size_t num);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <zephyr/syscalls/syscall_batch.h>
+
+#endif /* !_ASMLANGUAGE */
+#endif /* ZEPHYR_INCLUDE_KERNEL_SYSCALL_BATCH_H_ */
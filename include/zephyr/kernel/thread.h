@@ -90,7 +90,8 @@ struct _thread_base {
 	int prio_deadline;
 #endif /* CONFIG_SCHED_DEADLINE */
 
-#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE)
+#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE) || \
+	(defined(CONFIG_SCHED_BITMAP) && defined(CONFIG_SCHED_DEADLINE))
 	uint32_t order_key;
 #endif
 
@@ -0,0 +1,164 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Thread pools
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_THREAD_POOL_H_
+#define ZEPHYR_INCLUDE_KERNEL_THREAD_POOL_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup thread_pool_apis Thread Pool APIs
+ * @ingroup kernel_apis
+ *
+ * A thread pool owns a fixed set of thread objects and stacks. Each thread is
+ * created the first time it is needed, then parked between uses and reused to
+ * run new entry points, so spawning from a pool does not pay for the stack
+ * setup, the stack fill of @kconfig{CONFIG_INIT_STACKS} and the thread object
+ * initialization of k_thread_create(), nor for the thread teardown.
+ *
+ * A thread spawned from a pool returns to the pool once it has been joined
+ * with k_thread_pool_join(). Its entry point must return rather than abort
+ * the thread.
+ *
+ * Each spawn resets the memory domain of the thread to the one of the
+ * spawning thread, as k_thread_create() does, and errno and the custom data
+ * are cleared when the thread is parked. The stack and TLS area are not
+ * cleared between uses, so pool threads are supervisor threads: pools of user
+ * threads are not supported.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+
+struct k_thread_pool_job {
+	k_thread_entry_t entry;
+	void *p1;
+	void *p2;
+	void *p3;
+};
+
+struct k_thread_pool_worker {
+	sys_snode_t node;
+	struct k_msgq jobs;
+	struct k_thread_pool_job job_buf;
+	struct k_sem done;
+};
+
+/** @endcond */
+
+/**
+ * @brief Thread pool
+ *
+ * Defined with K_THREAD_POOL_DEFINE().
+ */
+struct k_thread_pool {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_thread *threads;
+	struct k_thread_pool_worker *workers;
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+	size_t stack_len;
+	uint32_t options;
+	uint16_t num_threads;
+	uint16_t num_created;
+	sys_slist_t idle;
+	struct k_sem avail;
+	struct k_spinlock lock;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically define and initialize a thread pool
+ *
+ * @param name Name of the thread pool.
+ * @param num_threads Number of threads in the pool.
+ * @param stack_size Stack size of each thread, in bytes.
+ * @param pool_options Thread options of the pool threads, see
+ *        k_thread_create(). K_USER is not supported.
+ */
+#define K_THREAD_POOL_DEFINE(name, num_threads, stack_size, pool_options)                   \
+	BUILD_ASSERT(((num_threads) > 0) && ((num_threads) <= UINT16_MAX),                    \
+		     "invalid number of pool threads");                                      \
+	BUILD_ASSERT(((pool_options) & K_USER) == 0,                                          \
+		     "pools of user threads are not supported");                             \
+	static K_THREAD_STACK_ARRAY_DEFINE(_k_thread_pool_stacks_##name, num_threads,         \
+					   stack_size);                                       \
+	static struct k_thread _k_thread_pool_threads_##name[num_threads];                    \
+	static struct k_thread_pool_worker _k_thread_pool_workers_##name[num_threads];        \
+	struct k_thread_pool name = {                                                         \
+		.threads = _k_thread_pool_threads_##name,                                     \
+		.workers = _k_thread_pool_workers_##name,                                     \
+		.stacks = _k_thread_pool_stacks_##name[0],                                    \
+		.stack_size = (stack_size),                                                   \
+		.stack_len = sizeof(_k_thread_pool_stacks_##name[0]),                         \
+		.options = (pool_options),                                                    \
+		.num_threads = (num_threads),                                                 \
+		.idle = SYS_SLIST_STATIC_INIT(&name.idle),                                    \
+		.avail = Z_SEM_INITIALIZER(name.avail, num_threads, num_threads),             \
+	}
+
+/**
+ * @brief Run an entry point on a thread of a pool
+ *
+ * Takes a parked thread of the pool, or creates one the first time it is
+ * needed, and makes it run @p entry. The thread must be joined with
+ * k_thread_pool_join() to return to the pool.
+ *
+ * Must be called from supervisor thread context.
+ *
+ * @param pool Thread pool.
+ * @param entry Entry point.
+ * @param p1 First entry point parameter.
+ * @param p2 Second entry point parameter.
+ * @param p3 Third entry point parameter.
+ * @param prio Thread priority.
+ * @param timeout Waiting period for a thread of the pool to be available,
+ *        or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return ID of the thread running @p entry, or NULL if no thread of the pool
+ *         became available before the timeout.
+ */
+k_tid_t k_thread_pool_spawn(struct k_thread_pool *pool, k_thread_entry_t entry,
+			    void *p1, void *p2, void *p3, int prio, k_timeout_t timeout);
+
+/**
+ * @brief Wait for a thread of a pool to complete its entry point
+ *
+ * On success, the thread returns to the pool and @p thread must not be used
+ * anymore. Only one thread may join a given spawned thread.
+ *
+ * Must be called from supervisor thread context.
+ *
+ * @param pool Thread pool.
+ * @param thread Thread returned by k_thread_pool_spawn().
+ * @param timeout Waiting period for the entry point to return, or one of the
+ *        special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 The entry point returned and the thread is back in the pool.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @p thread does not belong to @p pool.
+ */
+int k_thread_pool_join(struct k_thread_pool *pool, k_tid_t thread, k_timeout_t timeout);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_THREAD_POOL_H_ */
@@ -127,6 +127,22 @@ struct _priq_mq {
 #endif
 };
 
+/* Bitmap indexed multi-queue.  Like the traditional multi-queue, but
+ * the non-empty words of the priority bitmap are themselves tracked
+ * in a summary word, so the best priority is found with two
+ * find-first-set operations.  With deadline scheduling each priority
+ * is kept sorted by deadline in a red/black tree instead of a FIFO.
+ */
+struct _priq_bm {
+#ifdef CONFIG_SCHED_DEADLINE
+	struct _priq_rb queues[K_NUM_THREAD_PRIO];
+#else
+	sys_dlist_t queues[K_NUM_THREAD_PRIO];
+#endif /* CONFIG_SCHED_DEADLINE */
+	unsigned long summary;
+	unsigned long bitmask[PRIQ_BITMAP_SIZE];
+};
+
 struct _ready_q {
 #ifndef CONFIG_SMP
 	/* always contains next thread to run: cannot be NULL */
@@ -139,6 +155,8 @@ struct _ready_q {
 	struct _priq_rb runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
+#elif defined(CONFIG_SCHED_BITMAP)
+	struct _priq_bm runq;
 #endif
 };
 
@@ -135,6 +135,12 @@ extern char __kernel_ram_size[];
 extern char __bss_start[];
 extern char __bss_end[];
 
+#ifdef CONFIG_LAZY_BSS
+/* Zero-initialized objects cleared after boot, see lazy_bss_ensure() */
+extern char __lazy_bss_start[];
+extern char __lazy_bss_end[];
+#endif /* CONFIG_LAZY_BSS */
+
 /* Used by arch_data_copy() or arch-specific implementation */
 #ifdef CONFIG_XIP
 extern char __data_region_load_start[];
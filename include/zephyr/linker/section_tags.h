@@ -17,6 +17,14 @@
 
 #define __noinit		__in_section_unique(_NOINIT_SECTION_NAME)
 #define __noinit_named(name)	__in_section_unique_named(_NOINIT_SECTION_NAME, name)
+
+#ifdef CONFIG_LAZY_BSS
+/* Zero-initialized, but only cleared by lazy_bss_ensure() or the idle thread */
+#define __lazy_bss		__in_section_unique(_LAZY_BSS_SECTION_NAME)
+#else
+#define __lazy_bss
+#endif /* CONFIG_LAZY_BSS */
+
 #define __irq_vector_table	Z_GENERIC_SECTION(_IRQ_VECTOR_TABLE_SECTION_NAME)
 #define __sw_isr_table		Z_GENERIC_SECTION(_SW_ISR_TABLE_SECTION_NAME)
 
@@ -207,6 +207,12 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported for IPv4 and IPv6. Packets with
+	 * a non-zero net_pkt_gso_size() are split by the hardware into TCP
+	 * segments of that payload size, with their checksums computed.
+	 */
+	ETHERNET_HW_TX_TSO		= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
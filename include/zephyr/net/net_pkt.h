@@ -317,6 +317,13 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* TCP payload size of the segments this packet is split into
+	 * before it is transmitted, 0 if the packet is a single segment.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_PKT_CONTROL_BLOCK)
 	/* Control block which could be used by any layer */
 	union {
@@ -1184,6 +1191,31 @@ static inline void net_pkt_set_vlan_tci(struct net_pkt *pkt, uint16_t tci)
 }
 #endif
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_PKT_TIMESTAMP) || defined(CONFIG_NET_PKT_TXTIME)
 static inline struct net_ptp_time *net_pkt_timestamp(struct net_pkt *pkt)
 {
@@ -2358,6 +2390,25 @@ struct net_pkt *net_pkt_rx_clone(struct net_pkt *pkt, k_timeout_t timeout);
 struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt,
 				      k_timeout_t timeout);
 
+/**
+ * @brief Clone the headers of pkt followed by a part of its payload.
+ *
+ * @details The first hdr_len bytes of pkt are copied, then len bytes
+ *          starting at offset bytes after the headers. The cursor of pkt
+ *          is not modified. This is used to split a packet into segments.
+ *
+ * @param pkt Original pkt to be cloned
+ * @param hdr_len Length of the headers in pkt
+ * @param offset Offset of the payload to copy, after the headers
+ * @param len Length of the payload to copy
+ * @param timeout Timeout to wait for free buffer
+ *
+ * @return NULL if error, cloned packet otherwise.
+ */
+struct net_pkt *net_pkt_clone_segment(struct net_pkt *pkt, size_t hdr_len,
+				      size_t offset, size_t len,
+				      k_timeout_t timeout);
+
 /**
  * @brief Read some data from a net_pkt
  *
@@ -996,6 +996,8 @@ int zsock_sendmsg_all(int sock, const struct net_msghdr *msg, int flags,
 #define ZSOCK_TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define ZSOCK_TCP_KEEPCNT 4
+/** Name of the congestion control algorithm (string) */
+#define ZSOCK_TCP_CONGESTION 5
 
 /** @} */
 
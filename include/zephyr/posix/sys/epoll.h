@@ -0,0 +1,81 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_
+#define ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_
+
+#include <zephyr/zvfs/epoll.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EPOLLIN  ZVFS_EPOLLIN
+#define EPOLLPRI ZVFS_EPOLLPRI
+#define EPOLLOUT ZVFS_EPOLLOUT
+#define EPOLLERR ZVFS_EPOLLERR
+#define EPOLLHUP ZVFS_EPOLLHUP
+
+#define EPOLL_CTL_ADD ZVFS_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZVFS_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZVFS_EPOLL_CTL_MOD
+
+#define EPOLL_CLOEXEC ZVFS_EPOLL_CLOEXEC
+
+#define epoll_data  zvfs_epoll_data
+#define epoll_event zvfs_epoll_event
+
+typedef union zvfs_epoll_data epoll_data_t;
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @param size Ignored, but must be greater than zero
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int epoll_create(int size);
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @param flags 0 or EPOLL_CLOEXEC
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int epoll_create1(int flags);
+
+/**
+ * @brief Add, modify or remove an entry of the interest list of an epoll instance
+ *
+ * @param epfd Epoll file descriptor
+ * @param op EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ * @param fd Target file descriptor
+ * @param event Events of interest and user data
+ *
+ * @return 0 on success, -1 on error
+ */
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * Notification is level-triggered, EPOLLET and EPOLLONESHOT are not supported.
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array receiving the ready events
+ * @param maxevents Capacity of @p events
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of ready events, 0 on timeout, -1 on error
+ */
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_ */
@@ -0,0 +1,167 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Boot time profiling
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_BOOT_PROFILE_H_
+#define ZEPHYR_INCLUDE_PROFILING_BOOT_PROFILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/init.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup boot_profile Boot time profiling
+ * @ingroup os_services
+ *
+ * Records how long each boot phase, SYS_INIT() function and device
+ * initialization function takes between reset and the call to main().
+ *
+ * @{
+ */
+
+/** Boot phases timed outside of the init entries. */
+enum boot_profile_phase {
+	/** Zeroing of the BSS sections (arch_bss_zero()). */
+	BOOT_PROFILE_PHASE_BSS_ZERO,
+	/** Copy of the data sections from ROM (arch_data_copy()). */
+	BOOT_PROFILE_PHASE_DATA_COPY,
+	/** Architecture specific kernel initialization (arch_kernel_init()). */
+	BOOT_PROFILE_PHASE_ARCH_INIT,
+	/** From z_cstart() to the switch to the main thread. */
+	BOOT_PROFILE_PHASE_PRE_KERNEL,
+	/** From the start of the main thread to the call to main(). */
+	BOOT_PROFILE_PHASE_POST_KERNEL,
+	/** Number of boot phases. */
+	BOOT_PROFILE_PHASE_COUNT,
+};
+
+/** Timing of a boot phase or init entry. */
+struct boot_profile_record {
+	/** Init entry, NULL for boot phases. */
+	const struct init_entry *entry;
+	/** Timestamp at the start, see boot_profile_timestamp(). */
+	uint32_t start;
+	/** Duration, in cycles. */
+	uint32_t cycles;
+	/** Value returned by the init function. */
+	int16_t result;
+	/** Init level the entry ran at. */
+	uint8_t level;
+};
+
+#if defined(CONFIG_PROFILING_BOOT) || defined(__DOXYGEN__)
+
+/**
+ * @brief Get a boot profiling timestamp
+ *
+ * The default implementation returns k_cycle_get_32(). Platforms whose system
+ * timer does not count from reset can override this weak function with a free
+ * running counter to time the phases that precede the timer initialization.
+ *
+ * @return Timestamp, in system clock cycles.
+ */
+uint32_t boot_profile_timestamp(void);
+
+/**
+ * @brief Record the end of a boot phase
+ *
+ * @param phase Boot phase.
+ * @param start Timestamp taken at the start of the phase.
+ */
+void boot_profile_phase_record(enum boot_profile_phase phase, uint32_t start);
+
+/**
+ * @brief Record the end of an init entry
+ *
+ * May be called concurrently with parallel device initialization.
+ *
+ * @param entry Init entry.
+ * @param level Init level the entry ran at.
+ * @param start Timestamp taken before calling the entry.
+ * @param result Value returned by the entry.
+ */
+void boot_profile_entry_record(const struct init_entry *entry, int level, uint32_t start,
+			       int result);
+
+/**
+ * @brief Get the timing of a boot phase
+ *
+ * @param phase Boot phase.
+ *
+ * @return Record of the phase, with cycles set to 0 if it was not timed.
+ */
+const struct boot_profile_record *boot_profile_phase_get(enum boot_profile_phase phase);
+
+/**
+ * @brief Get the timings of the init entries
+ *
+ * @param records Set to the records, in completion order.
+ *
+ * @return Number of records. Entries beyond
+ * @kconfig{CONFIG_PROFILING_BOOT_MAX_ENTRIES} are not recorded.
+ */
+size_t boot_profile_entries_get(const struct boot_profile_record **records);
+
+/**
+ * @brief Get the name of a boot phase or init entry
+ *
+ * @param record Boot profile record.
+ *
+ * @return Phase, device or SYS_INIT() function name.
+ */
+const char *boot_profile_name(const struct boot_profile_record *record);
+
+/**
+ * @brief Print the boot profile as CSV with printk()
+ *
+ * The dump starts with a ``boot_profile,<version>,<cycles per second>`` line,
+ * followed by one ``<kind>,<name>,<level>,<priority>,<start us>,<duration us>,<result>``
+ * line per boot phase (kind ``phase``) and per init entry (kind ``sys_init`` or
+ * ``device``), and ends with a ``boot_profile,end`` line. It can be compared
+ * across builds with ``scripts/profiling/boot_profile_compare.py``.
+ */
+void boot_profile_dump(void);
+
+#else
+
+static inline uint32_t boot_profile_timestamp(void)
+{
+	return 0U;
+}
+
+static inline void boot_profile_phase_record(enum boot_profile_phase phase, uint32_t start)
+{
+	ARG_UNUSED(phase);
+	ARG_UNUSED(start);
+}
+
+static inline void boot_profile_entry_record(const struct init_entry *entry, int level,
+					     uint32_t start, int result)
+{
+	ARG_UNUSED(entry);
+	ARG_UNUSED(level);
+	ARG_UNUSED(start);
+	ARG_UNUSED(result);
+}
+
+#endif /* CONFIG_PROFILING_BOOT */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_BOOT_PROFILE_H_ */
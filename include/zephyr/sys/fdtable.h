@@ -358,6 +358,11 @@ ssize_t zvfs_read(int fd, void *buf, size_t sz, const size_t *from_offset);
  */
 ssize_t zvfs_write(int fd, const void *buf, size_t sz, const size_t *from_offset);
 
+#ifdef CONFIG_ZVFS_EPOLL
+/* Remove fd from the interest list of every epoll instance */
+void zvfs_epoll_close_fd(int fd);
+#endif
+
 #ifdef CONFIG_ZVFS_DEFAULT_FILE_VMETHODS
 int zvfs_ioctl_vmeth(void *obj, unsigned int request, va_list args);
 int zvfs_close_vmeth(void *obj);
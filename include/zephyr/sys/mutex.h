@@ -11,9 +11,12 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FAST, uncontended sys_mutexes are locked and
+ * unlocked with simple atomic ops instead of syscalls, similar to Linux's
+ * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI. The caller then accesses the mutex
+ * memory directly: a mutex outside of its memory domain faults like any
+ * other inaccessible memory, instead of failing with -EACCES, and an address
+ * which is not a sys_mutex is only rejected once the kernel is involved.
  */
 
 #ifdef __cplusplus
@@ -21,18 +24,30 @@ extern "C" {
 #endif
 
 #ifdef CONFIG_USERSPACE
+#include <errno.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
+#ifdef CONFIG_SYS_MUTEX_FAST
+#include <zephyr/kernel.h>
+#endif
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* With CONFIG_SYS_MUTEX_FAST, the owner thread (0 if unlocked),
+	 * or'ed with SYS_MUTEX_WAITERS while other threads are blocked on
+	 * the mutex in the kernel.  Unused otherwise.
 	 */
 	atomic_t val;
+#ifdef CONFIG_SYS_MUTEX_FAST
+	/* Recursive lock count, only accessed by the owner */
+	uint32_t lock_count;
+#endif
 };
 
+/* Thread objects are aligned, leaving the low bit of the owner free */
+#define SYS_MUTEX_WAITERS ((atomic_val_t)BIT(0))
+
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
  * @ingroup usermode_apis
@@ -67,11 +82,19 @@ struct sys_mutex {
  */
 static inline void sys_mutex_init(struct sys_mutex *mutex)
 {
+#ifdef CONFIG_SYS_MUTEX_FAST
+	/* The mutex state lives in the mutex word, kernel-side futex
+	 * data structures are initialized at boot
+	 */
+	atomic_set(&mutex->val, 0);
+	mutex->lock_count = 0U;
+#else
 	ARG_UNUSED(mutex);
 
 	/* Nothing to do, kernel-side data structures are initialized at
 	 * boot
 	 */
+#endif
 }
 
 __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -79,6 +102,11 @@ __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
 
 __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* Contended lock path, optionally spins before making the syscall */
+int z_sys_mutex_lock_contended(struct sys_mutex *mutex, k_timeout_t timeout);
+#endif
+
 /**
  * @brief Lock a mutex.
  *
@@ -96,13 +124,32 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval 0 Mutex locked.
  * @retval -EBUSY Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
- * @retval -EACCES Caller has no access to provided mutex address
- * @retval -EINVAL Provided mutex not recognized by the kernel
+ * @retval -EACCES Caller has no access to provided mutex address, without
+ *                 CONFIG_SYS_MUTEX_FAST (with it, the access faults)
+ * @retval -EINVAL Provided mutex not recognized by the kernel, or with
+ *                 CONFIG_SYS_MUTEX_FAST, the owner recorded in the mutex is
+ *                 not a thread the caller has permission on
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	atomic_val_t self = (atomic_val_t)k_current_get();
+
+	if (atomic_cas(&mutex->val, 0, self)) {
+		mutex->lock_count = 1U;
+		return 0;
+	}
+
+	if ((atomic_get(&mutex->val) & ~SYS_MUTEX_WAITERS) == self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	return z_sys_mutex_lock_contended(mutex, timeout);
+#else
+	/* Without a cheap k_current_get(), make the syscall unconditionally */
 	return z_sys_mutex_kernel_lock(mutex, timeout);
+#endif
 }
 
 /**
@@ -117,15 +164,40 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  *
  * @param mutex Address of the mutex, which may reside in user memory
  * @retval 0 Mutex unlocked
- * @retval -EACCES Caller has no access to provided mutex address
+ * @retval -EACCES Caller has no access to provided mutex address, without
+ *                 CONFIG_SYS_MUTEX_FAST (with it, the access faults)
  * @retval -EINVAL Provided mutex not recognized by the kernel or mutex wasn't
  *                 locked
  * @retval -EPERM Caller does not own the mutex
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	atomic_val_t self = (atomic_val_t)k_current_get();
+	atomic_val_t val = atomic_get(&mutex->val);
+
+	if (val == 0) {
+		return -EINVAL;
+	}
+
+	if ((val & ~SYS_MUTEX_WAITERS) != self) {
+		return -EPERM;
+	}
+
+	if (--mutex->lock_count > 0U) {
+		return 0;
+	}
+
+	if (atomic_cas(&mutex->val, self, 0)) {
+		return 0;
+	}
+
+	/* Waiters are blocked in the kernel, let it hand the mutex over */
 	return z_sys_mutex_kernel_unlock(mutex);
+#else
+	/* Without a cheap k_current_get(), make the syscall unconditionally */
+	return z_sys_mutex_kernel_unlock(mutex);
+#endif
 }
 
 #include <zephyr/syscalls/mutex.h>
@@ -65,6 +65,7 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	uint32_t elapsed_cycles;
 };
 
 /**
@@ -250,7 +251,8 @@ static inline bool sys_heap_validate(struct sys_heap *heap)
  * target_percent full.  Allocation and free operations are provided
  * by the caller as callbacks (i.e. this can in theory test any heap).
  * Results, including counts of frees and successful/unsuccessful
- * allocations, are returned via the @a result struct.
+ * allocations and the hardware cycles spent in the loop, are returned
+ * via the @a result struct.
  *
  * @param alloc_fn Callback to perform an allocation.  Passes back the @a
  *              arg parameter as a context handle.
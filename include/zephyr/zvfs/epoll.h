@@ -0,0 +1,96 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/fdtable.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLLIN  ZVFS_POLLIN
+#define ZVFS_EPOLLPRI ZVFS_POLLPRI
+#define ZVFS_EPOLLOUT ZVFS_POLLOUT
+#define ZVFS_EPOLLERR ZVFS_POLLERR
+#define ZVFS_EPOLLHUP ZVFS_POLLHUP
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+#define ZVFS_EPOLL_CLOEXEC 0x80000
+
+union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+};
+
+struct zvfs_epoll_event {
+	uint32_t events;
+	union zvfs_epoll_data data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance keeps a persistent interest list of file descriptors.
+ * Unlike @ref zvfs_poll, the descriptors are registered once with
+ * @ref zvfs_epoll_ctl, and @ref zvfs_epoll_wait only visits the ones that
+ * became ready, so its cost does not grow with the size of the interest list.
+ *
+ * Notification is level-triggered. Offloaded sockets are not supported.
+ *
+ * @param flags 0 or ZVFS_EPOLL_CLOEXEC (ignored)
+ *
+ * @return New ZVFS epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of a ZVFS epoll instance
+ *
+ * Descriptors closed with @ref zvfs_close are removed from the interest list
+ * of every epoll instance automatically.
+ *
+ * @param epfd Epoll file descriptor
+ * @param op ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd Target file descriptor
+ * @param event Events of interest and user data, ignored for ZVFS_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error with errno set
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for events on a ZVFS epoll instance
+ *
+ * A descriptor that cannot be registered again for its events after being
+ * reported is reported with ZVFS_EPOLLERR by every following call, until it
+ * is modified or removed with @ref zvfs_epoll_ctl.
+ *
+ * When more descriptors are ready than @p maxevents, the others are reported
+ * by the following calls.
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array receiving the ready events
+ * @param maxevents Capacity of @p events
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of ready events, 0 on timeout, -1 on error with errno set
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <string.h>
 #include <zephyr/device.h>
+#include <zephyr/kernel.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/kobject.h>
@@ -20,7 +21,14 @@ int do_device_init(const struct device *dev)
 	int rc = 0;
 
 	if (dev->ops.init != NULL) {
+#ifdef CONFIG_DEVICE_INIT_STATS
+		uint32_t start = k_cycle_get_32();
+
+		rc = dev->ops.init(dev);
+		dev->state->init_cycles = k_cycle_get_32() - start;
+#else
 		rc = dev->ops.init(dev);
+#endif /* CONFIG_DEVICE_INIT_STATS */
 		/* If initialization failed, record in dev->state->init_res
 		 * the POSITIVE value of the resulting errno
 		 */
@@ -196,6 +204,17 @@ bool z_impl_device_is_ready(const struct device *dev)
 	return dev->state->initialized && (dev->state->init_res == 0U);
 }
 
+#ifdef CONFIG_DEVICE_INIT_STATS
+uint32_t device_init_time_us(const struct device *dev)
+{
+	if (!dev->state->initialized) {
+		return 0U;
+	}
+
+	return k_cyc_to_us_floor32(dev->state->init_cycles);
+}
+#endif /* CONFIG_DEVICE_INIT_STATS */
+
 int z_impl_device_deinit(const struct device *dev)
 {
 #ifdef CONFIG_DEVICE_DEINIT_SUPPORT
@@ -11,6 +11,9 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/init.h>
 #include <ksched.h>
+#include <wait_q.h>
+#include <kernel_internal.h>
+#include <zephyr/sys/mutex.h>
 
 static struct z_futex_data *k_futex_find_data(struct k_futex *futex)
 {
@@ -103,3 +106,197 @@ static inline int z_vrfy_k_futex_wait(struct k_futex *futex, int expected,
 	return z_impl_k_futex_wait(futex, expected, timeout);
 }
 #include <zephyr/syscalls/k_futex_wait_mrsh.c>
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+/*
+ * Priority inheriting futexes, as used by sys_mutex.
+ *
+ * Userspace owns the futex word while it is uncontended: locking is a
+ * compare-and-swap of 0 to the caller's thread pointer, unlocking the
+ * reverse.  Contended operations land here.  A waiter sets
+ * SYS_MUTEX_WAITERS, which forces the owner's unlock into the kernel,
+ * boosts the owner as k_mutex would and pends on the wait queue of the
+ * kernel-side k_mutex of the sys_mutex.  Unlocking hands the futex
+ * directly to the highest priority waiter.
+ *
+ * All of the kernel side state, and the futex word while the waiters
+ * bit is set, is only modified under futex_pi_lock.
+ */
+static struct k_spinlock futex_pi_lock;
+
+static int32_t futex_pi_prio(int32_t target, int32_t limit)
+{
+	int32_t new_prio = z_is_prio_higher(target, limit) ? target : limit;
+
+	return z_get_new_prio_with_ceiling(new_prio);
+}
+
+/* The futex word is user writable: only trust it to name a thread once
+ * the object table agrees, and if the caller is a user thread, only a
+ * thread it has been granted permission on, as if it had been passed as
+ * a syscall argument. Otherwise any thread could be boosted.
+ */
+static struct k_thread *futex_pi_owner(atomic_val_t val)
+{
+	struct k_thread *owner = (struct k_thread *)(val & ~SYS_MUTEX_WAITERS);
+	struct k_object *ko = k_object_find(owner);
+
+	if ((_current->base.user_options & K_USER) != 0U) {
+		if (k_object_validate(ko, K_OBJ_THREAD, _OBJ_INIT_TRUE) != 0) {
+			return NULL;
+		}
+	} else if ((ko == NULL) || (ko->type != K_OBJ_THREAD) ||
+		   ((ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U)) {
+		return NULL;
+	}
+
+	return owner;
+}
+
+int z_futex_lock_pi(atomic_t *val, struct k_mutex *pi, k_timeout_t timeout)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	struct k_thread *owner;
+	k_spinlock_key_t key;
+	atomic_val_t v;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	key = k_spin_lock(&futex_pi_lock);
+
+	for (;;) {
+		v = atomic_get(val);
+
+		if (v == 0) {
+			/* Released since the caller looked: take it */
+			if (atomic_cas(val, 0, self)) {
+				k_spin_unlock(&futex_pi_lock, key);
+				return 0;
+			}
+			continue;
+		}
+
+		if ((v & ~SYS_MUTEX_WAITERS) == self) {
+			/* Recursion is handled in userspace, never here */
+			k_spin_unlock(&futex_pi_lock, key);
+			return -EINVAL;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&futex_pi_lock, key);
+			return -EBUSY;
+		}
+
+		owner = futex_pi_owner(v);
+		if (owner == NULL) {
+			k_spin_unlock(&futex_pi_lock, key);
+			return -EINVAL;
+		}
+
+		if (((v & SYS_MUTEX_WAITERS) != 0) ||
+		    atomic_cas(val, v, v | SYS_MUTEX_WAITERS)) {
+			break;
+		}
+	}
+
+	/* First waiter: the owner took the futex in userspace, record the
+	 * priority to restore on unlock.
+	 */
+	if ((v & SYS_MUTEX_WAITERS) == 0) {
+		pi->owner = owner;
+		pi->owner_orig_prio = owner->base.prio;
+	}
+
+	if (pi->owner == owner) {
+		int32_t new_prio = futex_pi_prio(_current->base.prio,
+						 owner->base.prio);
+
+		if (z_is_prio_higher(new_prio, owner->base.prio)) {
+			(void)z_thread_prio_set(owner, new_prio);
+		}
+	}
+
+	ret = z_pend_curr(&futex_pi_lock, key, &pi->wait_q, timeout);
+	if (ret == 0) {
+		/* Handed over by z_futex_unlock_pi(), the word is ours */
+		return 0;
+	}
+
+	key = k_spin_lock(&futex_pi_lock);
+
+	/* Timed out: drop the boost we may have contributed, and the
+	 * waiters bit if we were the last waiter.
+	 */
+	struct k_thread *waiter = z_waitq_head(&pi->wait_q);
+
+	v = atomic_get(val);
+	if ((pi->owner != NULL) &&
+	    ((struct k_thread *)(v & ~SYS_MUTEX_WAITERS) == pi->owner)) {
+		int32_t new_prio = (waiter != NULL) ?
+			futex_pi_prio(waiter->base.prio, pi->owner_orig_prio) :
+			pi->owner_orig_prio;
+
+		if (pi->owner->base.prio != new_prio) {
+			(void)z_thread_prio_set(pi->owner, new_prio);
+		}
+	}
+
+	if (waiter == NULL) {
+		(void)atomic_and(val, ~SYS_MUTEX_WAITERS);
+		pi->owner = NULL;
+	}
+
+	k_spin_unlock(&futex_pi_lock, key);
+
+	return -EAGAIN;
+}
+
+int z_futex_unlock_pi(atomic_t *val, struct k_mutex *pi)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	struct k_thread *new_owner;
+	k_spinlock_key_t key;
+	atomic_val_t v;
+
+	key = k_spin_lock(&futex_pi_lock);
+
+	v = atomic_get(val);
+	if (v == 0) {
+		k_spin_unlock(&futex_pi_lock, key);
+		return -EINVAL;
+	}
+
+	if ((v & ~SYS_MUTEX_WAITERS) != self) {
+		k_spin_unlock(&futex_pi_lock, key);
+		return -EPERM;
+	}
+
+	if ((pi->owner == _current) &&
+	    (_current->base.prio != pi->owner_orig_prio)) {
+		(void)z_thread_prio_set(_current, pi->owner_orig_prio);
+	}
+
+	new_owner = z_unpend_first_thread(&pi->wait_q);
+	pi->owner = new_owner;
+
+	if (new_owner == NULL) {
+		atomic_set(val, 0);
+		k_spin_unlock(&futex_pi_lock, key);
+		return 0;
+	}
+
+	/* As for k_mutex, the new owner already has the highest priority
+	 * of the remaining waiters, no need to boost it.
+	 */
+	atomic_set(val, (atomic_val_t)new_owner |
+		   ((z_waitq_head(&pi->wait_q) != NULL) ? SYS_MUTEX_WAITERS : 0));
+	pi->owner_orig_prio = new_owner->base.prio;
+
+	arch_thread_return_value_set(new_owner, 0);
+	z_ready_thread(new_owner);
+	z_reschedule(&futex_pi_lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
@@ -16,6 +16,7 @@
 #include <ksched.h>
 #include <kswap.h>
 #include <wait_q.h>
+#include <kernel_internal.h>
 
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
@@ -28,6 +29,21 @@ void idle(void *unused1, void *unused2, void *unused3)
 	__ASSERT_NO_MSG(_current->base.prio >= 0);
 
 	while (true) {
+#ifdef CONFIG_LAZY_BSS
+		/* Finish clearing the lazy BSS before idling, one chunk
+		 * at a time so that the idle thread stays preemptible.
+		 */
+		if (z_lazy_bss_idle()) {
+#if !defined(CONFIG_PREEMPT_ENABLED) && \
+	(!defined(CONFIG_USE_SWITCH) || defined(CONFIG_SPARC))
+			if (_kernel.ready_q.cache != _current) {
+				z_swap_unlocked();
+			}
+#endif
+			continue;
+		}
+#endif /* CONFIG_LAZY_BSS */
+
 		/* SMP systems without a working IPI can't actual
 		 * enter an idle state, because they can't be notified
 		 * of scheduler changes (i.e. threads they should
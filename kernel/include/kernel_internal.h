@@ -105,6 +105,32 @@ extern void smp_timer_init(void);
 
 extern void z_early_rand_get(uint8_t *buf, size_t length);
 
+#ifdef CONFIG_LAZY_BSS
+/**
+ * @brief Clear a chunk of the lazy BSS from the idle thread
+ *
+ * @return true if a chunk was cleared, false once the lazy BSS is cleared.
+ */
+bool z_lazy_bss_idle(void);
+#endif /* CONFIG_LAZY_BSS */
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+struct init_entry;
+
+/**
+ * @brief Initialize a run of devices on the parallel initialization threads
+ *
+ * @param start First init entry of the run, which must be a device.
+ * @param end End of the init level.
+ * @param level Init level being run.
+ *
+ * @return Last init entry of the run.
+ */
+const struct init_entry *z_device_init_parallel(const struct init_entry *start,
+						const struct init_entry *end,
+						int level);
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 #if defined(CONFIG_STACK_POINTER_RANDOM) && (CONFIG_STACK_POINTER_RANDOM != 0)
 extern int z_stack_adjust_initialized;
 #endif /* CONFIG_STACK_POINTER_RANDOM */
@@ -143,6 +169,16 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
  * not recommended.
  */
 extern struct k_spinlock z_mem_domain_lock;
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* Priority inheriting futex operations behind the sys_mutex slow paths.
+ * @a val holds the owner thread, or'ed with SYS_MUTEX_WAITERS while
+ * threads are pended on @a pi, whose owner fields track the boosted
+ * owner.
+ */
+int z_futex_lock_pi(atomic_t *val, struct k_mutex *pi, k_timeout_t timeout);
+int z_futex_unlock_pi(atomic_t *val, struct k_mutex *pi);
+#endif /* CONFIG_SYS_MUTEX_FAST */
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_GDBSTUB
@@ -224,6 +260,24 @@ void z_paging_histogram_inc(struct k_mem_paging_histogram_t *hist,
 			    uint32_t cycles);
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+#ifdef CONFIG_DEMAND_PAGING_REFAULT_STATS
+/**
+ * Remember a data page evicted to the backing store for refault statistics.
+ *
+ * @param addr Virtual address of the evicted data page.
+ */
+void z_paging_refault_evicted(void *addr);
+
+/**
+ * Get the refault distance histogram bin of a page fault.
+ *
+ * @param addr Virtual address of the faulting data page.
+ *
+ * @return Histogram bin, or -1 if the data page was not recently evicted.
+ */
+int z_paging_refault_bin(void *addr);
+#endif /* CONFIG_DEMAND_PAGING_REFAULT_STATS */
+
 #ifdef CONFIG_OBJ_CORE_STATS_THREAD
 int z_thread_stats_raw(struct k_obj_core *obj_core, void *stats);
 int z_thread_stats_query(struct k_obj_core *obj_core, void *stats);
@@ -269,6 +323,26 @@ void k_thread_abort_cleanup(struct k_thread *thread);
 void k_thread_abort_cleanup_check_reuse(struct k_thread *thread);
 #endif /* CONFIG_THREAD_ABORT_NEED_CLEANUP */
 
+/**
+ * @brief Get the system work queue serving the current CPU
+ *
+ * With CONFIG_SYSTEM_WORKQUEUE_PER_CPU each CPU has its own system work
+ * queue, and work submitted through the system work queue APIs goes to
+ * the one of the CPU the caller is running on.  Otherwise this is always
+ * @ref k_sys_work_q.
+ *
+ * The result is only a placement hint: the caller may migrate to another
+ * CPU right after the lookup, which is harmless.
+ */
+#ifdef CONFIG_SYSTEM_WORKQUEUE_PER_CPU
+struct k_work_q *z_sys_work_q_local(void);
+#else
+static inline struct k_work_q *z_sys_work_q_local(void)
+{
+	return &k_sys_work_q;
+}
+#endif /* CONFIG_SYSTEM_WORKQUEUE_PER_CPU */
+
 #ifdef __cplusplus
 }
 #endif
@@ -215,6 +215,20 @@ static ALWAYS_INLINE struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
  */
 bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
 
+#ifdef CONFIG_SMP
+/**
+ * Tells whether a thread is running on another CPU.
+ *
+ * Does not take the scheduler lock, so the answer may be stale as soon as
+ * it is returned: only meant for heuristics such as spinning while a lock
+ * owner runs.
+ *
+ * @param thread Thread to check
+ * @retval true If the thread was running on another CPU
+ */
+bool z_sched_thread_running_elsewhere(struct k_thread *thread);
+#endif /* CONFIG_SMP */
+
 /**
  * Wakes the specified thread.
  *
@@ -35,6 +35,13 @@
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_yield         z_priq_mq_yield
 #define _priq_run_best		z_priq_mq_best
+/* Bitmap Indexed Multi Queue Scheduling */
+#elif defined(CONFIG_SCHED_BITMAP)
+#define _priq_run_init		z_priq_bm_init
+#define _priq_run_add		z_priq_bm_add
+#define _priq_run_remove	z_priq_bm_remove
+#define _priq_run_yield         z_priq_bm_yield
+#define _priq_run_best		z_priq_bm_best
 #endif
 
 /* Scalable Wait Queue */
@@ -186,7 +193,8 @@ static ALWAYS_INLINE struct k_thread *z_priq_simple_mask_best(sys_dlist_t *pq)
 }
 #endif /* CONFIG_SCHED_CPU_MASK */
 
-#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE)
+#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE) || \
+	(defined(CONFIG_SCHED_BITMAP) && defined(CONFIG_SCHED_DEADLINE))
 static ALWAYS_INLINE void z_priq_rb_init(struct _priq_rb *pq)
 {
 	bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
@@ -348,6 +356,93 @@ static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 
 	return NULL;
 }
+
+#ifdef CONFIG_SCHED_BITMAP
+/* The summary word has one bit per word of the priority bitmap */
+BUILD_ASSERT(PRIQ_BITMAP_SIZE <= NBITS, "too many priorities for the bitmap ready queue");
+
+static ALWAYS_INLINE void z_priq_bm_init(struct _priq_bm *pq)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pq->queues); i++) {
+#ifdef CONFIG_SCHED_DEADLINE
+		z_priq_rb_init(&pq->queues[i]);
+#else
+		sys_dlist_init(&pq->queues[i]);
+#endif /* CONFIG_SCHED_DEADLINE */
+	}
+}
+
+static ALWAYS_INLINE void z_priq_bm_add(struct _priq_bm *pq, struct k_thread *thread)
+{
+	struct prio_info pos = get_prio_info(thread->base.prio);
+
+#ifdef CONFIG_SCHED_DEADLINE
+	z_priq_rb_add(&pq->queues[pos.offset_prio], thread);
+#else
+	sys_dlist_append(&pq->queues[pos.offset_prio], &thread->base.qnode_dlist);
+#endif /* CONFIG_SCHED_DEADLINE */
+
+	pq->bitmask[pos.idx] |= BIT(pos.bit);
+	pq->summary |= BIT(pos.idx);
+}
+
+static ALWAYS_INLINE void z_priq_bm_remove(struct _priq_bm *pq, struct k_thread *thread)
+{
+	struct prio_info pos = get_prio_info(thread->base.prio);
+	bool empty;
+
+#ifdef CONFIG_SCHED_DEADLINE
+	z_priq_rb_remove(&pq->queues[pos.offset_prio], thread);
+	empty = pq->queues[pos.offset_prio].tree.root == NULL;
+#else
+	sys_dlist_dequeue(&thread->base.qnode_dlist);
+	empty = sys_dlist_is_empty(&pq->queues[pos.offset_prio]);
+#endif /* CONFIG_SCHED_DEADLINE */
+
+	if (unlikely(empty)) {
+		pq->bitmask[pos.idx] &= ~BIT(pos.bit);
+		if (pq->bitmask[pos.idx] == 0) {
+			pq->summary &= ~BIT(pos.idx);
+		}
+	}
+}
+
+static ALWAYS_INLINE void z_priq_bm_yield(struct _priq_bm *pq)
+{
+#ifndef CONFIG_SMP
+	struct prio_info pos = get_prio_info(_current->base.prio);
+
+#ifdef CONFIG_SCHED_DEADLINE
+	z_priq_rb_remove(&pq->queues[pos.offset_prio], _current);
+	z_priq_rb_add(&pq->queues[pos.offset_prio], _current);
+#else
+	sys_dlist_dequeue(&_current->base.qnode_dlist);
+	sys_dlist_append(&pq->queues[pos.offset_prio], &_current->base.qnode_dlist);
+#endif /* CONFIG_SCHED_DEADLINE */
+#endif /* !CONFIG_SMP */
+}
+
+static ALWAYS_INLINE struct k_thread *z_priq_bm_best(struct _priq_bm *pq)
+{
+	unsigned int idx;
+	unsigned int index;
+
+	if (unlikely(pq->summary == 0)) {
+		return NULL;
+	}
+
+	idx = TRAILING_ZEROS(pq->summary);
+	index = idx * NBITS + TRAILING_ZEROS(pq->bitmask[idx]);
+
+#ifdef CONFIG_SCHED_DEADLINE
+	return z_priq_rb_best(&pq->queues[index]);
+#else
+	return CONTAINER_OF(sys_dlist_peek_head_not_empty(&pq->queues[index]),
+			    struct k_thread, base.qnode_dlist);
+#endif /* CONFIG_SCHED_DEADLINE */
+}
+#endif /* CONFIG_SCHED_BITMAP */
+
 #ifdef IAR_SUPPRESS_ALWAYS_INLINE_WARNING_FLAG
 TOOLCHAIN_ENABLE_WARNING(TOOLCHAIN_WARNING_ALWAYS_INLINE)
 #endif
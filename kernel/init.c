@@ -40,6 +40,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/arch/common/init.h>
+#include <zephyr/profiling/boot_profile.h>
 
 LOG_MODULE_REGISTER(os, CONFIG_KERNEL_LOG_LEVEL);
 
@@ -235,8 +236,17 @@ static void z_sys_init_run_level(enum init_level level)
 
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
 		const struct device *dev = entry->dev;
+		uint32_t start;
 		int result = 0;
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+		if ((dev != NULL) && (level >= INIT_LEVEL_POST_KERNEL)) {
+			entry = z_device_init_parallel(entry, levels[level+1], level);
+			continue;
+		}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
+		start = boot_profile_timestamp();
 		sys_trace_sys_init_enter(entry, level);
 		if (dev != NULL) {
 			if ((dev->flags & DEVICE_FLAG_INIT_DEFERRED) == 0U) {
@@ -246,6 +256,7 @@ static void z_sys_init_run_level(enum init_level level)
 			result = entry->init_fn();
 		}
 		sys_trace_sys_init_exit(entry, level, result);
+		boot_profile_entry_record(entry, level, start, result);
 	}
 }
 
@@ -286,6 +297,8 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	ARG_UNUSED(unused2);
 	ARG_UNUSED(unused3);
 
+	uint32_t post_kernel_start = boot_profile_timestamp();
+
 #ifdef CONFIG_MMU
 	/* Invoked here such that backing store or eviction algorithms may
 	 * initialize kernel objects, and that all POST_KERNEL and later tasks
@@ -334,6 +347,11 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	z_mem_manage_boot_finish();
 #endif /* CONFIG_MMU */
 
+	boot_profile_phase_record(BOOT_PROFILE_PHASE_POST_KERNEL, post_kernel_start);
+#ifdef CONFIG_PROFILING_BOOT_DUMP
+	boot_profile_dump();
+#endif /* CONFIG_PROFILING_BOOT_DUMP */
+
 #ifdef CONFIG_BOOTARGS
 	extern int main(int, char **);
 	extern char **prepare_main_args(int *argc);
@@ -537,6 +555,9 @@ __boot_func
 FUNC_NO_STACK_PROTECTOR
 FUNC_NORETURN void z_cstart(void)
 {
+	uint32_t pre_kernel_start = boot_profile_timestamp();
+	uint32_t arch_init_start;
+
 	/* gcov hook needed to get the coverage report.*/
 	gcov_static_init();
 
@@ -544,7 +565,9 @@ FUNC_NORETURN void z_cstart(void)
 	z_sys_init_run_level(INIT_LEVEL_EARLY);
 
 	/* perform any architecture-specific initialization */
+	arch_init_start = boot_profile_timestamp();
 	arch_kernel_init();
+	boot_profile_phase_record(BOOT_PROFILE_PHASE_ARCH_INIT, arch_init_start);
 
 	LOG_CORE_INIT();
 
@@ -578,6 +601,8 @@ FUNC_NORETURN void z_cstart(void)
 	timing_start();
 #endif /* CONFIG_TIMING_FUNCTIONS_NEED_AT_BOOT */
 
+	boot_profile_phase_record(BOOT_PROFILE_PHASE_PRE_KERNEL, pre_kernel_start);
+
 #ifdef CONFIG_MULTITHREADING
 	switch_to_main_thread(prepare_multithreading());
 #else
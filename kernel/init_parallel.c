@@ -0,0 +1,198 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Parallel device initialization
+ *
+ * Runs of consecutive device init entries of a level are initialized by a
+ * pool of threads. A device is started once the devices it requires that are
+ * part of the same run have completed, the remaining ties being broken by
+ * link order.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/profiling/boot_profile.h>
+#include <zephyr/tracing/tracing.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <kernel_internal.h>
+
+#define NUM_WORKERS CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+/* defined in device.c */
+extern int do_device_init(const struct device *dev);
+
+static struct {
+	struct k_spinlock lock;
+	_wait_q_t wait_q;
+	/* First entry of the run that may still be queued */
+	const struct init_entry *next;
+	/* End of the run */
+	const struct init_entry *end;
+	int level;
+	/* Devices of the run that are not started yet */
+	size_t queued;
+	/* Devices of the run being initialized */
+	size_t running;
+} run;
+
+static struct k_thread workers[NUM_WORKERS];
+static K_KERNEL_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+
+static bool is_queued(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+
+	return (dev != NULL) && dev->state->init_queued;
+}
+
+static bool deps_completed(const struct device *dev)
+{
+	const device_handle_t *handles;
+	size_t count;
+
+	handles = device_required_handles_get(dev, &count);
+	for (size_t i = 0; i < count; i++) {
+		const struct device *req = device_from_handle(handles[i]);
+
+		/* Devices outside of the run are as initialized as they will
+		 * get, as with sequential initialization.
+		 */
+		if ((req != NULL) && req->state->init_pending) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static const struct init_entry *pick_entry(void)
+{
+	const struct init_entry *entry;
+
+	while ((run.next < run.end) && !is_queued(run.next)) {
+		run.next++;
+	}
+
+	for (entry = run.next; entry < run.end; entry++) {
+		if (is_queued(entry) && deps_completed(entry->dev)) {
+			return entry;
+		}
+	}
+
+	/* Nothing can start while nothing runs: the dependencies loop, fall
+	 * back to link order rather than deadlocking the boot.
+	 */
+	if ((run.queued > 0U) && (run.running == 0U)) {
+		return run.next;
+	}
+
+	return NULL;
+}
+
+static void init_entries(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&run.lock);
+
+	while (true) {
+		const struct init_entry *entry = pick_entry();
+		uint32_t start;
+		int result;
+
+		if (entry == NULL) {
+			if (run.queued == 0U) {
+				break;
+			}
+
+			/* Wait for a device to complete */
+			(void)z_pend_curr(&run.lock, key, &run.wait_q, K_FOREVER);
+			key = k_spin_lock(&run.lock);
+			continue;
+		}
+
+		entry->dev->state->init_queued = false;
+		run.queued--;
+		run.running++;
+		k_spin_unlock(&run.lock, key);
+
+		start = boot_profile_timestamp();
+		sys_trace_sys_init_enter(entry, run.level);
+		result = do_device_init(entry->dev);
+		sys_trace_sys_init_exit(entry, run.level, result);
+		boot_profile_entry_record(entry, run.level, start, result);
+
+		key = k_spin_lock(&run.lock);
+		entry->dev->state->init_pending = false;
+		run.running--;
+		z_sched_wake_all(&run.wait_q, 0, NULL);
+	}
+
+	k_spin_unlock(&run.lock, key);
+}
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	init_entries();
+}
+
+const struct init_entry *z_device_init_parallel(const struct init_entry *start,
+						const struct init_entry *end,
+						int level)
+{
+	const struct init_entry *entry;
+	k_spinlock_key_t key;
+	size_t num_workers;
+
+	z_waitq_init(&run.wait_q);
+	run.next = start;
+	run.level = level;
+	run.queued = 0U;
+	run.running = 0U;
+
+	for (entry = start; (entry < end) && (entry->dev != NULL); entry++) {
+		const struct device *dev = entry->dev;
+
+		if ((dev->flags & DEVICE_FLAG_INIT_DEFERRED) == 0U) {
+			dev->state->init_queued = true;
+			dev->state->init_pending = true;
+			run.queued++;
+		}
+	}
+	run.end = entry;
+
+	/* The calling thread initializes devices too */
+	num_workers = (run.queued > 1U) ? MIN(run.queued - 1U, NUM_WORKERS) : 0U;
+	for (size_t i = 0; i < num_workers; i++) {
+		k_thread_create(&workers[i], worker_stacks[i],
+				K_KERNEL_STACK_SIZEOF(worker_stacks[i]), worker_entry,
+				NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		(void)k_thread_name_set(&workers[i], "device_init");
+	}
+
+	init_entries();
+
+	/* The last devices may still be initializing on other threads */
+	key = k_spin_lock(&run.lock);
+	while (run.running > 0U) {
+		(void)z_pend_curr(&run.lock, key, &run.wait_q, K_FOREVER);
+		key = k_spin_lock(&run.lock);
+	}
+	k_spin_unlock(&run.lock, key);
+
+	for (size_t i = 0; i < num_workers; i++) {
+		(void)k_thread_join(&workers[i], K_FOREVER);
+	}
+
+	return run.end - 1;
+}
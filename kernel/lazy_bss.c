@@ -0,0 +1,66 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/lazy_bss.h>
+#include <zephyr/linker/linker-defs.h>
+#include <kernel_internal.h>
+
+static struct k_spinlock lazy_bss_lock;
+
+/* The lazy BSS is cleared in order, everything below this is zeroed */
+static char *lazy_bss_cleared = __lazy_bss_start;
+
+/* Set once all of the lazy BSS is zeroed, so that the lock is not taken anymore */
+static atomic_t lazy_bss_done;
+
+static bool clear_chunk(const char *target)
+{
+	k_spinlock_key_t key;
+	size_t len;
+
+	if (atomic_get(&lazy_bss_done) != 0) {
+		return false;
+	}
+
+	key = k_spin_lock(&lazy_bss_lock);
+
+	if (lazy_bss_cleared >= target) {
+		k_spin_unlock(&lazy_bss_lock, key);
+		return false;
+	}
+
+	len = MIN((size_t)(target - lazy_bss_cleared), CONFIG_LAZY_BSS_CHUNK_SIZE);
+	(void)memset(lazy_bss_cleared, 0, len);
+	lazy_bss_cleared += len;
+
+	if (lazy_bss_cleared == __lazy_bss_end) {
+		atomic_set(&lazy_bss_done, 1);
+	}
+
+	k_spin_unlock(&lazy_bss_lock, key);
+
+	return true;
+}
+
+void lazy_bss_ensure(const void *obj, size_t size)
+{
+	const char *end = (const char *)obj + size;
+
+	__ASSERT(((const char *)obj >= __lazy_bss_start) && (end <= __lazy_bss_end),
+		 "%p is not a lazy BSS object", obj);
+
+	while (clear_chunk(end)) {
+		/* Let interrupts in between chunks */
+	}
+}
+
+bool z_lazy_bss_idle(void)
+{
+	return clear_chunk(__lazy_bss_end);
+}
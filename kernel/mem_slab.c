@@ -18,6 +18,243 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Number of blocks moved at once between a CPU cache and the free list */
+#define CPU_CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+
+/*
+ * Lock ordering: the slab lock nests outside the CPU cache locks.  The
+ * fast paths therefore never hold a cache lock while taking the slab
+ * lock; blocks moving between a cache and the free list transit through
+ * a local array instead.
+ *
+ * A thread about to fail or block on an empty free list bumps
+ * cpu_cache_waiters, then reclaims all cached blocks.  CPUs putting
+ * blocks into their cache check the counter with the cache lock held
+ * and back off to the slow path if it is set, so every block is either
+ * seen by the reclaim or handed to the waiter by the slow path.
+ */
+
+static inline struct k_mem_slab_cpu_cache *cpu_cache_get(struct k_mem_slab *slab)
+{
+	/* Interrupts must be locked, so that we can't migrate */
+	return &slab->cpu_cache[arch_curr_cpu()->id];
+}
+
+/* Return blocks to the free list, serving waiting threads first. */
+static void cpu_cache_flush(struct k_mem_slab *slab, void **blocks, uint32_t n)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	bool resched = false;
+
+	for (uint32_t i = 0; i < n; i++) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+		if (pending_thread != NULL) {
+			z_thread_return_value_set_with_data(pending_thread, 0, blocks[i]);
+			z_ready_thread(pending_thread);
+			resched = true;
+		} else {
+			*(char **)blocks[i] = slab->free_list;
+			slab->free_list = blocks[i];
+			slab->info.num_used--;
+		}
+	}
+
+	if (resched) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+
+/* Move all blocks held in CPU caches back to the free list.
+ *
+ * Invoked with slab lock held.
+ */
+static void cpu_cache_reclaim_locked(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			while (cache->count > 0U) {
+				char *mem = cache->blocks[--cache->count];
+
+				*(char **)mem = slab->free_list;
+				slab->free_list = mem;
+				slab->info.num_used--;
+			}
+		}
+	}
+}
+
+/* Allocate a block from the cache of the current CPU, refilling the cache
+ * from the free list if it is empty.
+ *
+ * @return true if a block was allocated, false if the free list is empty.
+ */
+static bool cpu_cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int irq = arch_irq_lock();
+	struct k_mem_slab_cpu_cache *cache = cpu_cache_get(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	if (likely(cache->count > 0U)) {
+		*mem = cache->blocks[--cache->count];
+		cache->hits++;
+		k_spin_unlock(&cache->lock, key);
+		arch_irq_unlock(irq);
+
+		return true;
+	}
+
+	cache->misses++;
+	k_spin_unlock(&cache->lock, key);
+
+	/* Only reclaiming CPUs can touch the cache until we lock it again,
+	 * and they only ever empty it, so there will be room for the refill.
+	 */
+	void *blocks[CPU_CACHE_BATCH + 1];
+	uint32_t n = 0U;
+
+	key = k_spin_lock(&slab->lock);
+	while ((n < ARRAY_SIZE(blocks)) && (slab->free_list != NULL)) {
+		blocks[n++] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+	}
+	slab->info.num_used += n;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = max(slab->info.num_used,
+				  slab->info.max_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+	k_spin_unlock(&slab->lock, key);
+
+	if (n == 0U) {
+		arch_irq_unlock(irq);
+
+		return false;
+	}
+
+	/* Hand out the most recently freed block, cache the others */
+	*mem = blocks[0];
+
+	key = k_spin_lock(&cache->lock);
+	for (uint32_t i = n - 1U; i > 0U; i--) {
+		cache->blocks[cache->count++] = blocks[i];
+	}
+
+	/* Someone started waiting while the blocks were in transit: give
+	 * them back rather than keeping them from the waiter.
+	 */
+	n = 0U;
+	if (atomic_get(&slab->cpu_cache_waiters) != 0) {
+		while (cache->count > 0U) {
+			blocks[n++] = cache->blocks[--cache->count];
+		}
+	}
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+
+	if (n > 0U) {
+		cpu_cache_flush(slab, blocks, n);
+	}
+
+	return true;
+}
+
+/* Free a block into the cache of the current CPU, flushing half of the
+ * cache to the free list if it is full.
+ *
+ * @return true if the block was freed, false if threads are waiting for a
+ * block and the slow path must be taken.
+ */
+static bool cpu_cache_free(struct k_mem_slab *slab, void *mem)
+{
+	void *blocks[CPU_CACHE_BATCH];
+	uint32_t n = 0U;
+	unsigned int irq = arch_irq_lock();
+	struct k_mem_slab_cpu_cache *cache = cpu_cache_get(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	if (unlikely(atomic_get(&slab->cpu_cache_waiters) != 0)) {
+		k_spin_unlock(&cache->lock, key);
+		arch_irq_unlock(irq);
+
+		return false;
+	}
+
+	if (cache->count == CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+		/* Flush the coldest blocks, from the bottom of the cache */
+		n = CPU_CACHE_BATCH;
+		cache->count -= n;
+		memcpy(blocks, cache->blocks, n * sizeof(void *));
+		memmove(cache->blocks, &cache->blocks[n],
+			cache->count * sizeof(void *));
+	}
+	cache->blocks[cache->count++] = mem;
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+
+	if (n > 0U) {
+		cpu_cache_flush(slab, blocks, n);
+	}
+
+	return true;
+}
+
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab)
+{
+	uint32_t used = slab->info.num_used;
+	uint32_t cached = 0U;
+
+	/* Unlocked snapshot, which may straddle a refill or flush */
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		cached += slab->cpu_cache[i].count;
+	}
+
+	return (used > cached) ? (used - cached) : 0U;
+}
+
+#if defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+/* Invoked with slab lock held. */
+static void cpu_cache_stats_get_locked(struct k_mem_slab *slab,
+				       struct k_mem_slab_info *info)
+{
+	info->num_cached = 0U;
+	info->cache_hits = 0U;
+	info->cache_misses = 0U;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			info->num_cached += cache->count;
+			info->cache_hits += cache->hits;
+			info->cache_misses += cache->misses;
+		}
+	}
+
+	/* Report blocks in use by the application only */
+	info->num_used -= info->num_cached;
+}
+
+/* Invoked with slab lock held. */
+static void cpu_cache_stats_reset_locked(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			cache->hits = 0U;
+			cache->misses = 0U;
+		}
+	}
+}
+#endif /* CONFIG_OBJ_CORE_STATS_MEM_SLAB */
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -33,6 +270,9 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	cpu_cache_stats_get_locked(slab, stats);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +288,10 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) *
 			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) *
+			       slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -75,6 +316,10 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	slab->info.max_used = slab->info.num_used;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	cpu_cache_stats_reset_locked(slab);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -184,6 +429,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+	atomic_clear(&slab->cpu_cache_waiters);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -221,11 +471,31 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cpu_cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	bool reclaimed = false;
+
+	if (slab->free_list == NULL) {
+		/* Announce ourselves before looking into the CPU caches */
+		atomic_inc(&slab->cpu_cache_waiters);
+		cpu_cache_reclaim_locked(slab);
+		reclaimed = true;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -256,11 +526,21 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		atomic_dec(&slab->cpu_cache_waiters);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (reclaimed) {
+		atomic_dec(&slab->cpu_cache_waiters);
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 	k_spin_unlock(&slab->lock, key);
@@ -276,6 +556,15 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cpu_cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -308,8 +597,9 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) *
+				 slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -1198,6 +1198,7 @@ struct k_mem_paging_stats_t paging_stats;
 extern struct k_mem_paging_histogram_t z_paging_histogram_eviction;
 extern struct k_mem_paging_histogram_t z_paging_histogram_backing_store_page_in;
 extern struct k_mem_paging_histogram_t z_paging_histogram_backing_store_page_out;
+extern struct k_mem_paging_histogram_t z_paging_histogram_page_fault;
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 
 static inline void do_backing_store_page_in(uintptr_t location)
@@ -1357,6 +1358,9 @@ static int page_frame_prepare_locked(struct k_mem_page_frame *pf, bool *dirty_pt
 		if (IS_ENABLED(CONFIG_EVICTION_TRACKING)) {
 			k_mem_paging_eviction_remove(pf);
 		}
+#ifdef CONFIG_DEMAND_PAGING_REFAULT_STATS
+		z_paging_refault_evicted(k_mem_page_frame_to_virt(pf));
+#endif /* CONFIG_DEMAND_PAGING_REFAULT_STATS */
 	} else {
 		/* Shouldn't happen unless this function is mis-used */
 		__ASSERT(!dirty, "un-mapped page determined to be dirty");
@@ -1577,6 +1581,46 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_refault_inc(struct k_thread *faulting_thread,
+					    void *addr)
+{
+#ifdef CONFIG_DEMAND_PAGING_REFAULT_STATS
+	int bin = z_paging_refault_bin(addr);
+
+	if (bin < 0) {
+		return;
+	}
+
+	paging_stats.refaults.cnt++;
+	paging_stats.refaults.distance[bin]++;
+
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.refaults.cnt++;
+	faulting_thread->paging_stats.refaults.distance[bin]++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#else
+	ARG_UNUSED(faulting_thread);
+	ARG_UNUSED(addr);
+#endif /* CONFIG_DEMAND_PAGING_REFAULT_STATS */
+}
+
+static inline void paging_stats_prefetch_inc(struct k_thread *faulting_thread)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.pagefaults.prefetched++;
+
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.pagefaults.prefetched++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline struct k_mem_page_frame *do_eviction_select(bool *dirty)
 {
 	struct k_mem_page_frame *pf;
@@ -1611,16 +1655,156 @@ static inline struct k_mem_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+/*
+ * Load the data page at addr from page_in_location in the backing store into
+ * a free or evicted page frame, and map it. Called with z_mm_lock held through
+ * key, which is released while accessing the backing store if
+ * CONFIG_DEMAND_PAGING_ALLOW_IRQ is enabled.
+ */
+static struct k_mem_page_frame *page_in_locked(void *addr, uintptr_t page_in_location,
+					       bool pin, struct k_thread *faulting_thread,
+					       k_spinlock_key_t *key)
+{
+	struct k_mem_page_frame *pf;
+	uintptr_t page_out_location;
+	bool dirty = false;
+	int ret;
+
+	pf = free_page_frame_list_get();
+	if (pf == NULL) {
+		/* Need to evict a page frame */
+		pf = do_eviction_select(&dirty);
+		__ASSERT(pf != NULL, "failed to get a page frame");
+		LOG_DBG("evicting %p at 0x%lx",
+			k_mem_page_frame_to_virt(pf),
+			k_mem_page_frame_to_phys(pf));
+
+		paging_stats_eviction_inc(faulting_thread, dirty);
+	}
+	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
+	__ASSERT(ret == 0, "failed to prepare page frame");
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	k_spin_unlock(&z_mm_lock, *key);
+	/* Interrupts are now unlocked if they were not locked when we entered
+	 * this function, and we may service ISRs. The scheduler is still
+	 * locked.
+	 */
+#else
+	ARG_UNUSED(key);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(page_out_location);
+	}
+	do_backing_store_page_in(page_in_location);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	*key = k_spin_lock(&z_mm_lock);
+	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_BUSY);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_MAPPED);
+	frame_mapped_set(pf, addr);
+	if (pin) {
+		k_mem_page_frame_set(pf, K_MEM_PAGE_FRAME_PINNED);
+	}
+
+	arch_mem_page_in(addr, k_mem_page_frame_to_phys(pf));
+	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+	if (IS_ENABLED(CONFIG_EVICTION_TRACKING) && (!pin)) {
+		k_mem_paging_eviction_add(pf);
+	}
+
+	return pf;
+}
+
+/* page_in_locked() for a page fault, accounted in the page fault histogram */
+static inline struct k_mem_page_frame *do_page_fault_page_in(void *addr,
+							     uintptr_t page_in_location,
+							     bool pin,
+							     struct k_thread *faulting_thread,
+							     k_spinlock_key_t *key)
+{
+	struct k_mem_page_frame *pf;
+
+#ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
+	uint32_t time_diff;
+
+#ifdef CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS
+	timing_t time_start, time_end;
+
+	time_start = timing_counter_get();
+#else
+	uint32_t time_start;
+
+	time_start = k_cycle_get_32();
+#endif /* CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS */
+#endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
+
+	pf = page_in_locked(addr, page_in_location, pin, faulting_thread, key);
+
+#ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
+#ifdef CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS
+	time_end = timing_counter_get();
+	time_diff = (uint32_t)timing_cycles_get(&time_start, &time_end);
+#else
+	time_diff = k_cycle_get_32() - time_start;
+#endif /* CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS */
+
+	z_paging_histogram_inc(&z_paging_histogram_page_fault, time_diff);
+#endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
+
+	return pf;
+}
+
+#if CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0
+/*
+ * Load the data pages following the faulting one, as long as they are paged
+ * out. These are not counted as page faults.
+ */
+static void page_fault_prefetch_locked(void *addr, struct k_mem_page_frame *fault_pf,
+				       struct k_thread *faulting_thread,
+				       k_spinlock_key_t *key)
+{
+	uint8_t *next = (uint8_t *)ROUND_DOWN(addr, CONFIG_MMU_PAGE_SIZE);
+	uintptr_t location;
+
+	/* The faulting page is about to be accessed, don't evict it */
+	if (IS_ENABLED(CONFIG_EVICTION_TRACKING)) {
+		k_mem_paging_eviction_remove(fault_pf);
+	}
+	k_mem_page_frame_set(fault_pf, K_MEM_PAGE_FRAME_PINNED);
+
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_PREFETCH_PAGES; i++) {
+		next += CONFIG_MMU_PAGE_SIZE;
+
+		/* Also stops on wrap around */
+		if (((uintptr_t)next - (uintptr_t)K_MEM_VIRT_RAM_START) >= K_MEM_VIRT_RAM_SIZE) {
+			break;
+		}
+
+		if (arch_page_location_get(next, &location) != ARCH_PAGE_LOCATION_PAGED_OUT) {
+			break;
+		}
+
+		(void)page_in_locked(next, location, false, faulting_thread, key);
+		paging_stats_prefetch_inc(faulting_thread);
+	}
+
+	k_mem_page_frame_clear(fault_pf, K_MEM_PAGE_FRAME_PINNED);
+	if (IS_ENABLED(CONFIG_EVICTION_TRACKING)) {
+		k_mem_paging_eviction_add(fault_pf);
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0 */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct k_mem_page_frame *pf;
 	k_spinlock_key_t key;
-	uintptr_t page_in_location, page_out_location;
+	uintptr_t page_in_location;
 	enum arch_page_location status;
 	bool result;
-	bool dirty = false;
 	struct k_thread *faulting_thread;
-	int ret;
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
 		 addr);
@@ -1710,48 +1894,15 @@ static bool do_page_fault(void *addr, bool pin)
 		 "unexpected status value %d", status);
 
 	paging_stats_faults_inc(faulting_thread, key.key);
+	paging_stats_refault_inc(faulting_thread, addr);
 
-	pf = free_page_frame_list_get();
-	if (pf == NULL) {
-		/* Need to evict a page frame */
-		pf = do_eviction_select(&dirty);
-		__ASSERT(pf != NULL, "failed to get a page frame");
-		LOG_DBG("evicting %p at 0x%lx",
-			k_mem_page_frame_to_virt(pf),
-			k_mem_page_frame_to_phys(pf));
-
-		paging_stats_eviction_inc(faulting_thread, dirty);
-	}
-	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
-	__ASSERT(ret == 0, "failed to prepare page frame");
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	k_spin_unlock(&z_mm_lock, key);
-	/* Interrupts are now unlocked if they were not locked when we entered
-	 * this function, and we may service ISRs. The scheduler is still
-	 * locked.
-	 */
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
-	}
-	do_backing_store_page_in(page_in_location);
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	key = k_spin_lock(&z_mm_lock);
-	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_BUSY);
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_MAPPED);
-	frame_mapped_set(pf, addr);
-	if (pin) {
-		k_mem_page_frame_set(pf, K_MEM_PAGE_FRAME_PINNED);
-	}
+	pf = do_page_fault_page_in(addr, page_in_location, pin, faulting_thread, &key);
 
-	arch_mem_page_in(addr, k_mem_page_frame_to_phys(pf));
-	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
-	if (IS_ENABLED(CONFIG_EVICTION_TRACKING) && (!pin)) {
-		k_mem_paging_eviction_add(pf);
+#if CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0
+	if (!pin) {
+		page_fault_prefetch_locked(addr, pf, faulting_thread, &key);
 	}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0 */
 out:
 	k_spin_unlock(&z_mm_lock, key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -50,6 +50,14 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->read_ptr = buffer;
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
+#ifdef CONFIG_MSGQ_MPSC
+	atomic_set(&msgq->mpsc_free, (atomic_val_t)max_msgs);
+	atomic_set(&msgq->mpsc_used, 0);
+	atomic_set(&msgq->mpsc_reserve, 0);
+	atomic_set(&msgq->mpsc_commit, 0);
+	atomic_set(&msgq->mpsc_waiters, 0);
+	z_waitq_init(&msgq->mpsc_put_wait_q);
+#endif /* CONFIG_MSGQ_MPSC */
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
@@ -113,6 +121,13 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 		goto exit;
 	}
 
+#ifdef CONFIG_MSGQ_MPSC
+	CHECKIF(z_waitq_head(&msgq->mpsc_put_wait_q) != NULL) {
+		ret = -EBUSY;
+		goto exit;
+	}
+#endif /* CONFIG_MSGQ_MPSC */
+
 	if ((msgq->flags & K_MSGQ_FLAG_ALLOC) != 0U) {
 		k_free(msgq->buffer_start);
 		msgq->flags &= ~K_MSGQ_FLAG_ALLOC;
@@ -123,6 +138,215 @@ exit:
 	return ret;
 }
 
+#ifdef CONFIG_MSGQ_MPSC
+/*
+ * Lock-free producers: a slot is first reserved by decrementing the free
+ * count, then claimed by advancing the reserve index.  Once the message
+ * is copied, the slot is published by advancing the commit index and the
+ * used count, in reservation order, so that readers only ever see
+ * contiguous complete messages.  Readers still hold the lock, and only
+ * the reader side moves read_ptr.
+ */
+static inline atomic_val_t mpsc_next_slot(struct k_msgq *msgq, atomic_val_t slot)
+{
+	return ((uint32_t)slot + 1U == msgq->max_msgs) ? 0 : slot + 1;
+}
+
+static bool mpsc_reserve(struct k_msgq *msgq)
+{
+	atomic_val_t free_msgs;
+
+	do {
+		free_msgs = atomic_get(&msgq->mpsc_free);
+		if (free_msgs == 0) {
+			return false;
+		}
+	} while (!atomic_cas(&msgq->mpsc_free, free_msgs, free_msgs - 1));
+
+	return true;
+}
+
+static bool mpsc_put(struct k_msgq *msgq, const void *data)
+{
+	atomic_val_t slot;
+	unsigned int key;
+
+	if (!mpsc_reserve(msgq)) {
+		return false;
+	}
+
+	/* Later producers wait for this slot to be published, so don't let
+	 * anything run on this CPU until it is.
+	 */
+	key = arch_irq_lock();
+
+	do {
+		slot = atomic_get(&msgq->mpsc_reserve);
+	} while (!atomic_cas(&msgq->mpsc_reserve, slot, mpsc_next_slot(msgq, slot)));
+
+	(void)memcpy(msgq->buffer_start + ((size_t)slot * msgq->msg_size), data,
+		     msgq->msg_size);
+
+	while (atomic_get(&msgq->mpsc_commit) != slot) {
+		arch_spin_relax();
+	}
+	atomic_set(&msgq->mpsc_commit, mpsc_next_slot(msgq, slot));
+	atomic_inc(&msgq->mpsc_used);
+
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+/* Must be called with the lock held */
+static bool mpsc_get(struct k_msgq *msgq, void *data)
+{
+	if (atomic_get(&msgq->mpsc_used) == 0) {
+		return false;
+	}
+
+	(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
+	msgq->read_ptr += msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+
+	atomic_dec(&msgq->mpsc_used);
+	atomic_inc(&msgq->mpsc_free);
+
+	return true;
+}
+
+/* Wake up the first thread waiting for what was just made available, a
+ * message or a free slot, so it can try again.  Each message put or got
+ * wakes up at most one thread.  Must be called with the lock held, which
+ * is released.
+ */
+static void mpsc_wake_waiter(struct k_msgq *msgq, k_spinlock_key_t key, bool data_available)
+{
+	struct k_thread *pending_thread;
+	bool resched = false;
+
+	pending_thread = z_unpend_first_thread(data_available ? &msgq->wait_q
+							      : &msgq->mpsc_put_wait_q);
+	if (pending_thread != NULL) {
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+	}
+
+	if (data_available) {
+		resched = handle_poll_events(msgq) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+static int put_msg_in_queue(struct k_msgq *msgq, const void *data,
+			    k_timeout_t timeout, bool put_at_back)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	if (!put_at_back) {
+		/* Putting at the front moves read_ptr, which belongs to readers */
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_front, msgq, timeout);
+
+		key = k_spin_lock(&msgq->lock);
+		if (mpsc_reserve(msgq)) {
+			if (msgq->read_ptr == msgq->buffer_start) {
+				msgq->read_ptr = msgq->buffer_end;
+			}
+			msgq->read_ptr -= msgq->msg_size;
+			(void)memcpy(msgq->read_ptr, data, msgq->msg_size);
+			atomic_inc(&msgq->mpsc_used);
+			result = 0;
+		} else {
+			result = -ENOMSG;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_front, msgq, timeout, result);
+
+		if ((result == 0) && (atomic_get(&msgq->mpsc_waiters) != 0)) {
+			mpsc_wake_waiter(msgq, key, true);
+		} else {
+			k_spin_unlock(&msgq->lock, key);
+		}
+
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	if (likely(mpsc_put(msgq, data))) {
+		if (unlikely(atomic_get(&msgq->mpsc_waiters) != 0)) {
+			key = k_spin_lock(&msgq->lock);
+			mpsc_wake_waiter(msgq, key, true);
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
+
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, -ENOMSG);
+
+		return -ENOMSG;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+	key = k_spin_lock(&msgq->lock);
+
+	while (true) {
+		/* Let readers see us before trying one last time, so that
+		 * either they wake us up or we find the slot they freed.
+		 */
+		atomic_inc(&msgq->mpsc_waiters);
+		if (mpsc_put(msgq, data)) {
+			atomic_dec(&msgq->mpsc_waiters);
+			break;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			atomic_dec(&msgq->mpsc_waiters);
+			k_spin_unlock(&msgq->lock, key);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, -EAGAIN);
+
+			return -EAGAIN;
+		}
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->mpsc_put_wait_q, timeout);
+		atomic_dec(&msgq->mpsc_waiters);
+		if (result != 0) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+			return result;
+		}
+
+		key = k_spin_lock(&msgq->lock);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
+
+	if (atomic_get(&msgq->mpsc_waiters) != 0) {
+		mpsc_wake_waiter(msgq, key, true);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+#else
 static inline int put_msg_in_queue(struct k_msgq *msgq, const void *data,
 			k_timeout_t timeout, bool put_at_back)
 {
@@ -220,6 +444,7 @@ static inline int put_msg_in_queue(struct k_msgq *msgq, const void *data,
 
 	return result;
 }
+#endif /* CONFIG_MSGQ_MPSC */
 
 
 int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
@@ -257,7 +482,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_impl_k_msgq_num_used_get(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -271,6 +496,70 @@ static inline void z_vrfy_k_msgq_get_attrs(struct k_msgq *msgq,
 #include <zephyr/syscalls/k_msgq_get_attrs_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_MSGQ_MPSC
+int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	if (likely(mpsc_get(msgq, data))) {
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+		while (true) {
+			/* Let producers see us before looking one last time,
+			 * so that either they wake us up or we find their
+			 * message.
+			 */
+			atomic_inc(&msgq->mpsc_waiters);
+			if (mpsc_get(msgq, data)) {
+				atomic_dec(&msgq->mpsc_waiters);
+				result = 0;
+				break;
+			}
+
+			timeout = sys_timepoint_timeout(end);
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				atomic_dec(&msgq->mpsc_waiters);
+				result = -EAGAIN;
+				break;
+			}
+
+			result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+			atomic_dec(&msgq->mpsc_waiters);
+			if (result != 0) {
+				SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+				return result;
+			}
+
+			key = k_spin_lock(&msgq->lock);
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	/* A slot was freed, let blocked producers retry */
+	if ((result == 0) && (atomic_get(&msgq->mpsc_waiters) != 0)) {
+		mpsc_wake_waiter(msgq, key, false);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+#else
 int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -339,6 +628,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	return result;
 }
+#endif /* CONFIG_MSGQ_MPSC */
 
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
@@ -359,7 +649,7 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs > 0U) {
+	if (z_impl_k_msgq_num_used_get(msgq) > 0U) {
 		/* take first available message from queue */
 		(void)memcpy((char *)data, msgq->read_ptr, msgq->msg_size);
 		result = 0;
@@ -396,7 +686,7 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs > idx) {
+	if (z_impl_k_msgq_num_used_get(msgq) > idx) {
 		bytes_to_end = (msgq->buffer_end - msgq->read_ptr);
 		byte_offset = idx * msgq->msg_size;
 		start_addr = msgq->read_ptr;
@@ -432,27 +722,53 @@ static inline int z_vrfy_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_
 #include <zephyr/syscalls/k_msgq_peek_at_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-void z_impl_k_msgq_purge(struct k_msgq *msgq)
+static bool purge_wait_q(_wait_q_t *wait_q)
 {
-	k_spinlock_key_t key;
 	struct k_thread *pending_thread;
 	bool resched = false;
 
-	key = k_spin_lock(&msgq->lock);
-
-	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
-
-	/* wake up any threads that are waiting to write */
-	for (pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	for (pending_thread = z_unpend_first_thread(wait_q);
 	     pending_thread != NULL;
-	     pending_thread = z_unpend_first_thread(&msgq->wait_q)) {
+	     pending_thread = z_unpend_first_thread(wait_q)) {
 		arch_thread_return_value_set(pending_thread, -ENOMSG);
 		z_ready_thread(pending_thread);
 		resched = true;
 	}
 
+	return resched;
+}
+
+void z_impl_k_msgq_purge(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key;
+	bool resched;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
+
+	/* wake up any threads that are waiting to write */
+	resched = purge_wait_q(&msgq->wait_q);
+
+#ifdef CONFIG_MSGQ_MPSC
+	resched = purge_wait_q(&msgq->mpsc_put_wait_q) || resched;
+
+	/* Only drop published messages, producers may be filling more */
+	atomic_val_t used = atomic_get(&msgq->mpsc_used);
+
+	if (used != 0) {
+		size_t offset = (msgq->read_ptr - msgq->buffer_start) +
+				((size_t)used * msgq->msg_size);
+		size_t size = msgq->buffer_end - msgq->buffer_start;
+
+		msgq->read_ptr = msgq->buffer_start + (offset % size);
+		atomic_sub(&msgq->mpsc_used, used);
+		atomic_add(&msgq->mpsc_free, used);
+	}
+#else
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+#endif /* CONFIG_MSGQ_MPSC */
 
 	if (resched) {
 		z_reschedule(&msgq->lock, key);
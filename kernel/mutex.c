@@ -102,6 +102,61 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+#define MUTEX_SPIN_BACKOFF_MAX 64U
+
+/* Called with the lock held on a mutex owned by another thread.  Spins,
+ * without the lock, while the owner keeps running on another CPU and
+ * nobody is queued (the mutex would be handed over to the waiter, not
+ * released).  The lock is only taken again to take the mutex: returns
+ * true, with the lock held, if the mutex became free.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	volatile uint32_t *lock_count = &mutex->lock_count;
+	struct k_thread *volatile *owner = &mutex->owner;
+	uint32_t backoff = 1U;
+	unsigned int irq_key;
+
+	if (z_waitq_head(&mutex->wait_q) != NULL) {
+		return false;
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	for (int i = 0; i < CONFIG_MUTEX_SPIN_LIMIT; i++) {
+		struct k_thread *cur_owner = *owner;
+
+		if ((*lock_count == 0U) || (cur_owner == NULL)) {
+			*key = k_spin_lock(&lock);
+			if (mutex->lock_count == 0U) {
+				return true;
+			}
+
+			/* Taken by someone else in the meantime */
+			if (z_waitq_head(&mutex->wait_q) != NULL) {
+				return false;
+			}
+			k_spin_unlock(&lock, *key);
+		} else if (!z_sched_thread_running_elsewhere(cur_owner)) {
+			break;
+		}
+
+		/* arch_spin_relax() expects interrupts masked */
+		irq_key = arch_irq_lock();
+		for (uint32_t n = 0; n < backoff; n++) {
+			arch_spin_relax();
+		}
+		arch_irq_unlock(irq_key);
+		backoff = MIN(backoff * 2U, MUTEX_SPIN_BACKOFF_MAX);
+	}
+
+	*key = k_spin_lock(&lock);
+
+	return mutex->lock_count == 0U;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -142,6 +197,22 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if (mutex_spin(mutex, &key)) {
+		mutex->owner_orig_prio = _current->base.prio;
+		mutex->lock_count = 1U;
+		mutex->owner = _current;
+
+		LOG_DBG("%p took mutex %p after spinning", _current, mutex);
+
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
@@ -16,6 +16,7 @@ extern struct k_mem_paging_stats_t paging_stats;
 struct k_mem_paging_histogram_t z_paging_histogram_eviction;
 struct k_mem_paging_histogram_t z_paging_histogram_backing_store_page_in;
 struct k_mem_paging_histogram_t z_paging_histogram_backing_store_page_out;
+struct k_mem_paging_histogram_t z_paging_histogram_page_fault;
 
 #ifdef CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS
 
@@ -76,6 +77,27 @@ k_mem_paging_backing_store_histogram_bounds[
 #endif /* CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS */
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+#ifdef CONFIG_DEMAND_PAGING_REFAULT_STATS
+/* Data page virtual addresses are page aligned, mark used shadow entries */
+#define REFAULT_SHADOW_VALID	BIT(0)
+
+/*
+ * Recently evicted data pages, indexed by virtual page number, along with
+ * the eviction count at the time of their eviction.
+ */
+static struct {
+	uintptr_t page;
+	uint32_t evictions;
+} refault_shadows[CONFIG_DEMAND_PAGING_REFAULT_SHADOW_ENTRIES];
+
+static uint32_t refault_evictions;
+
+static inline size_t refault_shadow_idx(uintptr_t page)
+{
+	return (page / CONFIG_MMU_PAGE_SIZE) % CONFIG_DEMAND_PAGING_REFAULT_SHADOW_ENTRIES;
+}
+#endif /* CONFIG_DEMAND_PAGING_REFAULT_STATS */
+
 unsigned long k_mem_num_pagefaults_get(void)
 {
 	unsigned long ret;
@@ -108,6 +130,33 @@ void z_vrfy_k_mem_paging_stats_get(struct k_mem_paging_stats_t *stats)
 #include <zephyr/syscalls/k_mem_paging_stats_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+__weak void k_mem_paging_backing_store_stats(struct k_mem_paging_backing_store_stats_t *stats)
+{
+	ARG_UNUSED(stats);
+}
+
+void z_impl_k_mem_paging_backing_store_stats_get(
+	struct k_mem_paging_backing_store_stats_t *stats)
+{
+	if (stats == NULL) {
+		return;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+	k_mem_paging_backing_store_stats(stats);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline
+void z_vrfy_k_mem_paging_backing_store_stats_get(
+	struct k_mem_paging_backing_store_stats_t *stats)
+{
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(stats, sizeof(*stats)));
+	z_impl_k_mem_paging_backing_store_stats_get(stats);
+}
+#include <zephyr/syscalls/k_mem_paging_backing_store_stats_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 #ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
 void z_impl_k_mem_paging_thread_stats_get(struct k_thread *thread,
 					  struct k_mem_paging_stats_t *stats)
@@ -160,6 +209,13 @@ void z_paging_histogram_init(void)
 	memcpy(z_paging_histogram_backing_store_page_out.bounds,
 	       k_mem_paging_backing_store_histogram_bounds,
 	       sizeof(z_paging_histogram_backing_store_page_out.bounds));
+
+	/* Page faults are dominated by the backing store page-in */
+	memset(&z_paging_histogram_page_fault, 0,
+	       sizeof(z_paging_histogram_page_fault));
+	memcpy(z_paging_histogram_page_fault.bounds,
+	       k_mem_paging_backing_store_histogram_bounds,
+	       sizeof(z_paging_histogram_page_fault.bounds));
 }
 
 /**
@@ -219,6 +275,18 @@ void z_impl_k_mem_paging_histogram_backing_store_page_out_get(
 	       sizeof(z_paging_histogram_backing_store_page_out));
 }
 
+void z_impl_k_mem_paging_histogram_page_fault_get(
+	struct k_mem_paging_histogram_t *hist)
+{
+	if (hist == NULL) {
+		return;
+	}
+
+	/* Copy histogram */
+	memcpy(hist, &z_paging_histogram_page_fault,
+	       sizeof(z_paging_histogram_page_fault));
+}
+
 #ifdef CONFIG_USERSPACE
 static inline
 void z_vrfy_k_mem_paging_histogram_eviction_get(
@@ -246,6 +314,48 @@ void z_vrfy_k_mem_paging_histogram_backing_store_page_out_get(
 	z_impl_k_mem_paging_histogram_backing_store_page_out_get(hist);
 }
 #include <zephyr/syscalls/k_mem_paging_histogram_backing_store_page_out_get_mrsh.c>
+
+static inline
+void z_vrfy_k_mem_paging_histogram_page_fault_get(
+	struct k_mem_paging_histogram_t *hist)
+{
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(hist, sizeof(*hist)));
+	z_impl_k_mem_paging_histogram_page_fault_get(hist);
+}
+#include <zephyr/syscalls/k_mem_paging_histogram_page_fault_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
+
+#ifdef CONFIG_DEMAND_PAGING_REFAULT_STATS
+void z_paging_refault_evicted(void *addr)
+{
+	uintptr_t page = ROUND_DOWN((uintptr_t)addr, CONFIG_MMU_PAGE_SIZE);
+	size_t idx = refault_shadow_idx(page);
+
+	refault_shadows[idx].page = page | REFAULT_SHADOW_VALID;
+	refault_shadows[idx].evictions = refault_evictions;
+	refault_evictions++;
+}
+
+int z_paging_refault_bin(void *addr)
+{
+	uintptr_t page = ROUND_DOWN((uintptr_t)addr, CONFIG_MMU_PAGE_SIZE);
+	size_t idx = refault_shadow_idx(page);
+	uint32_t distance;
+
+	if (refault_shadows[idx].page != (page | REFAULT_SHADOW_VALID)) {
+		return -1;
+	}
+
+	refault_shadows[idx].page = 0U;
+
+	/* Evictions of other data pages since this one was evicted */
+	distance = refault_evictions - refault_shadows[idx].evictions - 1U;
+	if (distance == 0U) {
+		return 0;
+	}
+
+	return MIN(LOG2(distance) + 1, CONFIG_DEMAND_PAGING_REFAULT_HISTOGRAM_NUM_BINS - 1);
+}
+#endif /* CONFIG_DEMAND_PAGING_REFAULT_STATS */
@@ -34,6 +34,16 @@ static inline bool pipe_empty(struct k_pipe *pipe)
 	return ring_buf_is_empty(&pipe->buf);
 }
 
+static inline bool pipe_write_claimed(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_WRITE_CLAIM) != 0;
+}
+
+static inline bool pipe_read_claimed(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_READ_CLAIM) != 0;
+}
+
 static int wait_for(_wait_q_t *waitq, struct k_pipe *pipe, k_spinlock_key_t *key,
 		    k_timepoint_t time_limit, bool *need_resched)
 {
@@ -112,11 +122,17 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 				K_SPINLOCK_BREAK;
 			}
 
+			/* Readers blocked in k_pipe_read_claim() post an empty
+			 * spec: they are simply woken up to claim the data
+			 * about to be put in the ring buffer.
+			 */
 			reader_buf = reader->base.swap_data;
 			copy_size = min(len - written,
 					reader_buf->len - reader_buf->used);
-			memcpy(&reader_buf->data[reader_buf->used],
-			       &data[written], copy_size);
+			if (copy_size != 0) {
+				memcpy(&reader_buf->data[reader_buf->used],
+				       &data[written], copy_size);
+			}
 			written += copy_size;
 			reader_buf->used += copy_size;
 
@@ -160,6 +176,14 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 	}
 
 	for (;;) {
+		/* Checked again on each wakeup: a claim may have been taken
+		 * while waiting, and the ring buffer must not be touched then.
+		 */
+		if (unlikely(pipe_write_claimed(pipe))) {
+			rc = written ? written : -EBUSY;
+			break;
+		}
+
 		if (unlikely(pipe_closed(pipe))) {
 			rc = -EPIPE;
 			break;
@@ -233,6 +257,11 @@ int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout
 	}
 
 	for (;;) {
+		if (unlikely(pipe_read_claimed(pipe))) {
+			rc = buf.used ? buf.used : -EBUSY;
+			break;
+		}
+
 		if (pipe_full(pipe)) {
 			/* One or more pending writers may exist. */
 			need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
@@ -270,11 +299,174 @@ exit:
 	return rc;
 }
 
+int z_impl_k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+			      k_timeout_t timeout)
+{
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		/* Another writer may have claimed while we were waiting */
+		if (unlikely(pipe_write_claimed(pipe))) {
+			rc = -EBUSY;
+			break;
+		}
+
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		rc = ring_buf_put_claim(&pipe->buf, data, MIN(len, UINT32_MAX));
+		if (likely(rc > 0 || len == 0)) {
+			pipe->flags |= PIPE_FLAG_WRITE_CLAIM;
+			break;
+		}
+
+		rc = wait_for(&pipe->space, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	k_spin_unlock(&pipe->lock, key);
+	return rc;
+}
+
+int z_impl_k_pipe_write_commit(struct k_pipe *pipe, size_t len)
+{
+	int rc;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(!pipe_write_claimed(pipe))) {
+		/* Never claimed, or dropped by k_pipe_reset() */
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	if (unlikely(pipe_closed(pipe))) {
+		(void)ring_buf_put_finish(&pipe->buf, 0);
+		pipe->flags &= ~PIPE_FLAG_WRITE_CLAIM;
+		rc = -EPIPE;
+		goto exit;
+	}
+
+	rc = ring_buf_put_finish(&pipe->buf, MIN(len, UINT32_MAX));
+	if (rc != 0) {
+		goto exit;
+	}
+
+	pipe->flags &= ~PIPE_FLAG_WRITE_CLAIM;
+	rc = len;
+
+	if (len != 0) {
+		/* Readers loop back to the ring buffer once woken up */
+		need_resched = z_sched_wake_all(&pipe->data, 0, NULL);
+#ifdef CONFIG_POLL
+		need_resched |= z_handle_obj_poll_events(&pipe->poll_events,
+							 K_POLL_STATE_PIPE_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int z_impl_k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+			     k_timeout_t timeout)
+{
+	/* Nothing to copy: writers only need to wake us up */
+	struct pipe_buf_spec buf = { NULL, 0, 0 };
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		/* Another reader may have claimed while we were waiting */
+		if (unlikely(pipe_read_claimed(pipe))) {
+			rc = -EBUSY;
+			break;
+		}
+
+		rc = ring_buf_get_claim(&pipe->buf, data, MIN(len, UINT32_MAX));
+		if (likely(rc > 0 || len == 0)) {
+			pipe->flags |= PIPE_FLAG_READ_CLAIM;
+			break;
+		}
+
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		_current->base.swap_data = &buf;
+
+		rc = wait_for(&pipe->data, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	k_spin_unlock(&pipe->lock, key);
+	return rc;
+}
+
+int z_impl_k_pipe_read_finish(struct k_pipe *pipe, size_t len)
+{
+	int rc;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(!pipe_read_claimed(pipe))) {
+		/* Never claimed, or dropped by k_pipe_reset() */
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	rc = ring_buf_get_finish(&pipe->buf, MIN(len, UINT32_MAX));
+	if (rc != 0) {
+		goto exit;
+	}
+
+	pipe->flags &= ~PIPE_FLAG_READ_CLAIM;
+	rc = len;
+
+	if (len != 0) {
+		need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
 void z_impl_k_pipe_reset(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, reset, pipe);
 	K_SPINLOCK(&pipe->lock) {
 		ring_buf_reset(&pipe->buf);
+		pipe->flags &= ~(PIPE_FLAG_WRITE_CLAIM | PIPE_FLAG_READ_CLAIM);
 		if (likely(pipe->waiting != 0)) {
 			pipe->flags |= PIPE_FLAG_RESET;
 			z_sched_wake_all(&pipe->data, 0, NULL);
@@ -288,7 +480,8 @@ void z_impl_k_pipe_close(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, close, pipe);
 	K_SPINLOCK(&pipe->lock) {
-		pipe->flags = 0;
+		/* Outstanding claims can still be committed or finished */
+		pipe->flags &= PIPE_FLAG_WRITE_CLAIM | PIPE_FLAG_READ_CLAIM;
 		z_sched_wake_all(&pipe->data, 0, NULL);
 		z_sched_wake_all(&pipe->space, 0, NULL);
 	}
@@ -323,6 +516,46 @@ int z_vrfy_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 }
 #include <zephyr/syscalls/k_pipe_write_mrsh.c>
 
+int z_vrfy_k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+			      k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	/* The caller fills the claimed area in place */
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(pipe->buf.buffer, pipe->buf.size));
+
+	return z_impl_k_pipe_write_claim(pipe, data, len, timeout);
+}
+#include <zephyr/syscalls/k_pipe_write_claim_mrsh.c>
+
+int z_vrfy_k_pipe_write_commit(struct k_pipe *pipe, size_t len)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_write_commit(pipe, len);
+}
+#include <zephyr/syscalls/k_pipe_write_commit_mrsh.c>
+
+int z_vrfy_k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+			     k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	/* The caller consumes the claimed area in place */
+	K_OOPS(K_SYSCALL_MEMORY_READ(pipe->buf.buffer, pipe->buf.size));
+
+	return z_impl_k_pipe_read_claim(pipe, data, len, timeout);
+}
+#include <zephyr/syscalls/k_pipe_read_claim_mrsh.c>
+
+int z_vrfy_k_pipe_read_finish(struct k_pipe *pipe, size_t len)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_read_finish(pipe, len);
+}
+#include <zephyr/syscalls/k_pipe_read_finish_mrsh.c>
+
 void z_vrfy_k_pipe_reset(struct k_pipe *pipe)
 {
 	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
@@ -35,16 +35,16 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
 {
-	__ASSERT(mode == K_POLL_MODE_NOTIFY_ONLY,
-		 "only NOTIFY_ONLY mode is supported\n");
+	__ASSERT(mode < K_POLL_NUM_MODES, "invalid mode\n");
 	__ASSERT(type < (BIT(_POLL_NUM_TYPES)), "invalid type\n");
 	__ASSERT(obj != NULL, "must provide an object\n");
 
@@ -82,7 +82,7 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		if (event->msgq->used_msgs > 0) {
+		if (z_impl_k_msgq_num_used_get(event->msgq) > 0U) {
 			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
 			return true;
 		}
@@ -108,22 +108,35 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Only pollers blocked in k_poll() are threads with a priority; triggered
+ * work and poll sets rank below any of them, in registration order.
+ */
+static bool poller_outranks(struct z_poller *a, struct z_poller *b)
+{
+	if (a->mode != MODE_POLL) {
+		return false;
+	}
+
+	if (b->mode != MODE_POLL) {
+		return true;
+	}
+
+	return z_sched_prio_cmp(poller_thread(a), poller_thread(b)) > 0;
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || !poller_outranks(poller, pending->poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (poller_outranks(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -144,6 +157,9 @@ static inline void register_event(struct k_poll_event *event,
 	case K_POLL_TYPE_DATA_AVAILABLE:
 		__ASSERT(event->queue != NULL, "invalid queue\n");
 		add_event(&event->queue->poll_events, event, poller);
+#ifdef CONFIG_QUEUE_MPSC
+		atomic_inc(&event->queue->waiters);
+#endif /* CONFIG_QUEUE_MPSC */
 		break;
 	case K_POLL_TYPE_SIGNAL:
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
@@ -152,6 +168,9 @@ static inline void register_event(struct k_poll_event *event,
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
 		add_event(&event->msgq->poll_events, event, poller);
+#ifdef CONFIG_MSGQ_MPSC
+		atomic_inc(&event->msgq->mpsc_waiters);
+#endif /* CONFIG_MSGQ_MPSC */
 		break;
 	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
 		__ASSERT(event->pipe != NULL, "invalid pipe\n");
@@ -182,6 +201,9 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		break;
 	case K_POLL_TYPE_DATA_AVAILABLE:
 		__ASSERT(event->queue != NULL, "invalid queue\n");
+#ifdef CONFIG_QUEUE_MPSC
+		atomic_dec(&event->queue->waiters);
+#endif /* CONFIG_QUEUE_MPSC */
 		remove_event = true;
 		break;
 	case K_POLL_TYPE_SIGNAL:
@@ -190,6 +212,9 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
+#ifdef CONFIG_MSGQ_MPSC
+		atomic_dec(&event->msgq->mpsc_waiters);
+#endif /* CONFIG_MSGQ_MPSC */
 		remove_event = true;
 		break;
 	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
@@ -226,6 +251,27 @@ static inline void set_event_ready(struct k_poll_event *event, uint32_t state)
 	event->state |= state;
 }
 
+/* Clear the registrations of a poller that was woken up, and report in the
+ * same pass the other events whose condition is met by now, so that events
+ * becoming ready together are returned by a single k_poll() call.
+ */
+static inline void collect_event_registrations(struct k_poll_event *events,
+					       int num_events,
+					       k_spinlock_key_t key)
+{
+	while (num_events--) {
+		struct k_poll_event *event = &events[num_events];
+		uint32_t state;
+
+		clear_event_registration(event);
+		if (is_condition_met(event, &state)) {
+			event->state |= state;
+		}
+		k_spin_unlock(&lock, key);
+		key = k_spin_lock(&lock);
+	}
+}
+
 static inline int register_events(struct k_poll_event *events,
 				  int num_events,
 				  struct z_poller *poller,
@@ -244,6 +290,15 @@ static inline int register_events(struct k_poll_event *events,
 		} else if (!just_check && poller->is_polling) {
 			register_event(&events[ii], poller);
 			events_registered += 1;
+#if defined(CONFIG_QUEUE_MPSC) || defined(CONFIG_MSGQ_MPSC)
+			/* Lock-free producers only signal pollers they can
+			 * see, check again now that we are registered.
+			 */
+			if (is_condition_met(&events[ii], &state)) {
+				set_event_ready(&events[ii], state);
+				poller->is_polling = false;
+			}
+#endif
 		} else {
 			/* Event is not one of those identified in is_condition_met()
 			 * catching non-polling events, or is marked for just check,
@@ -339,7 +394,11 @@ int z_impl_k_poll(struct k_poll_event *events, int num_events,
 	 * return code first, which invalidates the whole list of event states.
 	 */
 	key = k_spin_lock(&lock);
-	clear_event_registrations(events, events_registered, key);
+	if (swap_rc == 0) {
+		collect_event_registrations(events, events_registered, key);
+	} else {
+		clear_event_registrations(events, events_registered, key);
+	}
 	k_spin_unlock(&lock, key);
 
 	SYS_PORT_TRACING_FUNC_EXIT(k_poll_api, poll, events, swap_rc);
@@ -388,7 +447,7 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 	for (int i = 0; i < num_events; i++) {
 		struct k_poll_event *e = &events_copy[i];
 
-		if (K_SYSCALL_VERIFY(e->mode == K_POLL_MODE_NOTIFY_ONLY)) {
+		if (K_SYSCALL_VERIFY(e->mode < K_POLL_NUM_MODES)) {
 			ret = -EINVAL;
 			goto out_free;
 		}
@@ -441,6 +500,8 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
 			retcode = signal_triggered_work(event, state);
+		} else if (poller->mode == MODE_SET) {
+			retcode = signal_poll_set(event, state);
 		} else {
 			/* Poller is not poll or triggered mode. No action needed.*/
 			;
@@ -523,12 +584,12 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_poll_event *poll_event;
+	int rc = 0;
 
 	sig->result = result;
 	sig->signaled = 1U;
 
-	poll_event = (struct k_poll_event *)sys_dlist_get(&sig->poll_events);
-	if (poll_event == NULL) {
+	if (sys_dlist_is_empty(&sig->poll_events)) {
 		k_spin_unlock(&lock, key);
 
 		SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, 0);
@@ -536,7 +597,16 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 		return 0;
 	}
 
-	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+	/* The signal stays raised until it is reset, so it satisfies every
+	 * registered poller: make them all ready, then reschedule once.
+	 */
+	while ((poll_event = (struct k_poll_event *)sys_dlist_get(&sig->poll_events)) != NULL) {
+		int ret = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+
+		if (ret < 0) {
+			rc = ret;
+		}
+	}
 
 	SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, rc);
 
@@ -778,7 +848,7 @@ int k_work_poll_submit(struct k_work_poll *work,
 {
 	SYS_PORT_TRACING_FUNC_ENTER(k_work_poll, submit, work, timeout);
 
-	int ret = k_work_poll_submit_to_queue(&k_sys_work_q, work,
+	int ret = k_work_poll_submit_to_queue(z_sys_work_q_local(), work,
 								events, num_events, timeout);
 
 	SYS_PORT_TRACING_FUNC_EXIT(k_work_poll, submit, work, timeout, ret);
@@ -808,3 +878,149 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* must be called with interrupts locked */
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller, struct k_poll_set, poller);
+	struct k_thread *thread;
+
+	/* The object already unlinked the event, drop what is left of the
+	 * registration and queue it for the next waiter.
+	 */
+	clear_event_registration(event);
+	sys_dlist_append(&set->ready, &event->_node);
+
+	/* An edge-triggered event handed out earlier still holds the state
+	 * of its previous report.
+	 */
+	if (event->mode == K_POLL_MODE_EDGE_TRIGGERED) {
+		event->state = K_POLL_STATE_NOT_READY;
+	}
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static void poll_set_arm(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (!is_condition_met(event, &state)) {
+		register_event(event, &set->poller);
+#if defined(CONFIG_QUEUE_MPSC) || defined(CONFIG_MSGQ_MPSC)
+		/* Lock-free producers only signal pollers they can
+		 * see, check again now that we are registered.
+		 */
+		if (!is_condition_met(event, &state)) {
+			return;
+		}
+
+		clear_event_registration(event);
+#else
+		return;
+#endif
+	}
+
+	set_event_ready(event, state);
+	sys_dlist_append(&set->ready, &event->_node);
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->collected);
+	z_waitq_init(&set->wait_q);
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_dnode_init(&event->_node);
+	poll_set_arm(set, event);
+
+	k_spin_unlock(&lock, key);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller == &set->poller) {
+		clear_event_registration(event);
+	} else if (sys_dnode_is_linked(&event->_node)) {
+		/* Sitting on the ready or collected list */
+		sys_dlist_remove(&event->_node);
+	} else {
+		/* Not part of the set, nothing to do */
+		;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready, int max,
+		    k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct k_poll_event *event;
+	k_spinlock_key_t key;
+	int count = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(ready != NULL, "NULL ready\n");
+	__ASSERT(max > 0, "<1 max\n");
+
+	/* Re-arm the events handed out by the previous wait, releasing the
+	 * lock in between for latency control as register_events() does.
+	 */
+	key = k_spin_lock(&lock);
+	while ((event = (struct k_poll_event *)sys_dlist_get(&set->collected)) != NULL) {
+		poll_set_arm(set, event);
+		k_spin_unlock(&lock, key);
+		key = k_spin_lock(&lock);
+	}
+
+	while (sys_dlist_is_empty(&set->ready)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return 0;
+		}
+
+		(void)z_pend_curr(&lock, key, &set->wait_q, timeout);
+
+		/* Another waiter may have taken the events that woke us up */
+		key = k_spin_lock(&lock);
+		timeout = sys_timepoint_timeout(end);
+	}
+
+	while ((count < max) &&
+	       ((event = (struct k_poll_event *)sys_dlist_get(&set->ready)) != NULL)) {
+		if (event->mode == K_POLL_MODE_EDGE_TRIGGERED) {
+			/* Back on its object right away, without checking
+			 * the condition: it fires again on the next signal
+			 * only. Changes that happened while the event was
+			 * queued are covered by this report.
+			 */
+			register_event(event, &set->poller);
+		} else {
+			sys_dlist_append(&set->collected, &event->_node);
+		}
+		ready[count++] = event;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
@@ -63,6 +63,10 @@ void z_impl_k_queue_init(struct k_queue *queue)
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
+#ifdef CONFIG_QUEUE_MPSC
+	(void)atomic_ptr_clear(&queue->staged);
+	(void)atomic_clear(&queue->waiters);
+#endif /* CONFIG_QUEUE_MPSC */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_queue, queue);
 
@@ -96,6 +100,98 @@ static inline bool handle_poll_events(struct k_queue *queue, uint32_t state)
 #endif /* CONFIG_POLL */
 }
 
+#ifdef CONFIG_QUEUE_MPSC
+/* Move the items appended by lock-free producers to the end of the data
+ * list.  Must be called with the queue lock held.
+ */
+static void drain_staged(struct k_queue *queue)
+{
+	void *node = atomic_ptr_set(&queue->staged, NULL);
+	void *head = NULL;
+	void *tail = node;
+
+	/* Producers push onto a stack, reverse it to restore their order */
+	while (node != NULL) {
+		void *next = *(void **)node;
+
+		*(void **)node = head;
+		head = node;
+		node = next;
+	}
+
+	if (head != NULL) {
+		sys_sflist_append_list(&queue->data_q, head, tail);
+	}
+}
+
+/* Same as above, for the operations that do not otherwise take the lock */
+static void flush_staged(struct k_queue *queue)
+{
+	if (atomic_ptr_get(&queue->staged) != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+		drain_staged(queue);
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+
+/* Lock-free append.  Returns false if a waiting thread or poller may have
+ * missed the item, in which case the caller must wake it up.
+ */
+static bool append_staged(struct k_queue *queue, void *data)
+{
+	void *head;
+
+	do {
+		head = atomic_ptr_get(&queue->staged);
+		*(void **)data = head;
+	} while (!atomic_ptr_cas(&queue->staged, head, data));
+
+	return atomic_get(&queue->waiters) == 0;
+}
+
+static void wake_waiters(struct k_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	struct k_thread *thread;
+	bool resched = false;
+
+	drain_staged(queue);
+
+	while (!sys_sflist_is_empty(&queue->data_q)) {
+		thread = z_unpend_first_thread(&queue->wait_q);
+		if (thread == NULL) {
+			break;
+		}
+
+		prepare_thread_to_run(thread,
+				      z_queue_node_peek(sys_sflist_get_not_empty(&queue->data_q),
+							true));
+		resched = true;
+	}
+
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		resched = handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&queue->lock, key);
+	} else {
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+#else
+static inline void drain_staged(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+
+static inline void flush_staged(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+#endif /* CONFIG_QUEUE_MPSC */
+
 void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 {
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, cancel_wait, queue);
@@ -139,6 +235,8 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, queue_insert, queue, alloc);
 
+	drain_staged(queue);
+
 	if (is_append) {
 		prev = sys_sflist_peek_tail(&queue->data_q);
 	}
@@ -198,7 +296,13 @@ void k_queue_append(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, append, queue);
 
+#ifdef CONFIG_QUEUE_MPSC
+	if (!append_staged(queue, data)) {
+		wake_waiters(queue);
+	}
+#else
 	(void)queue_insert(queue, NULL, data, false, true);
+#endif /* CONFIG_QUEUE_MPSC */
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, append, queue);
 }
@@ -269,6 +373,8 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
+	drain_staged(queue);
+
 	if (head != NULL) {
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
@@ -336,19 +442,14 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	void *data;
+	int ret;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, get, queue, timeout);
 
-	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
-		sys_sfnode_t *node;
-
-		node = sys_sflist_get_not_empty(&queue->data_q);
-		data = z_queue_node_peek(node, true);
-		k_spin_unlock(&queue->lock, key);
+	drain_staged(queue);
 
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, data);
-
-		return data;
+	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
+		goto take_head;
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_queue, get, queue, timeout);
@@ -361,18 +462,44 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 		return NULL;
 	}
 
-	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
+#ifdef CONFIG_QUEUE_MPSC
+	/* Let lock-free producers see us before looking one last time, so
+	 * that either they find a waiter or we find their item.
+	 */
+	atomic_inc(&queue->waiters);
+	drain_staged(queue);
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		atomic_dec(&queue->waiters);
+		goto take_head;
+	}
+#endif /* CONFIG_QUEUE_MPSC */
+
+	ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
+
+#ifdef CONFIG_QUEUE_MPSC
+	atomic_dec(&queue->waiters);
+#endif /* CONFIG_QUEUE_MPSC */
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout,
 		(ret != 0) ? NULL : _current->base.swap_data);
 
 	return (ret != 0) ? NULL : _current->base.swap_data;
+
+take_head:
+	data = z_queue_node_peek(sys_sflist_get_not_empty(&queue->data_q), true);
+	k_spin_unlock(&queue->lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, data);
+
+	return data;
 }
 
 bool k_queue_remove(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, remove, queue);
 
+	flush_staged(queue);
+
 	bool ret = sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, remove, queue, ret);
@@ -386,6 +513,8 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 	sys_sfnode_t *test;
 
+	flush_staged(queue);
+
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, unique_append, queue, false);
@@ -403,6 +532,8 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+	flush_staged(queue);
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_head, queue, ret);
@@ -412,6 +543,8 @@ void *z_impl_k_queue_peek_head(struct k_queue *queue)
 
 void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+	flush_staged(queue);
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_tail, queue, ret);
@@ -345,6 +345,19 @@ static struct _cpu *thread_active_elsewhere(struct k_thread *thread)
 	return NULL;
 }
 
+#ifdef CONFIG_SMP
+bool z_sched_thread_running_elsewhere(struct k_thread *thread)
+{
+	/* _current_cpu must not change under us */
+	unsigned int key = arch_irq_lock();
+	bool ret = thread_active_elsewhere(thread) != NULL;
+
+	arch_irq_unlock(key);
+
+	return ret;
+}
+#endif /* CONFIG_SMP */
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -0,0 +1,122 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/syscall_batch.h>
+#include <zephyr/internal/syscall_handler.h>
+
+static int batch_entry_run(struct k_syscall_batch_entry *entry)
+{
+	switch (entry->op) {
+	case K_SYSCALL_BATCH_SEM_GIVE:
+		z_impl_k_sem_give(entry->obj);
+		return 0;
+	case K_SYSCALL_BATCH_SEM_TAKE:
+		return z_impl_k_sem_take(entry->obj, entry->timeout);
+	case K_SYSCALL_BATCH_MSGQ_PUT:
+		return z_impl_k_msgq_put(entry->obj, entry->data, entry->timeout);
+	case K_SYSCALL_BATCH_MSGQ_GET:
+		return z_impl_k_msgq_get(entry->obj, entry->data, entry->timeout);
+#ifdef CONFIG_EVENTS
+	case K_SYSCALL_BATCH_EVENT_POST:
+		entry->value = z_impl_k_event_post(entry->obj, entry->value);
+		return 0;
+	case K_SYSCALL_BATCH_EVENT_SET:
+		entry->value = z_impl_k_event_set(entry->obj, entry->value);
+		return 0;
+#endif /* CONFIG_EVENTS */
+#ifdef CONFIG_POLL
+	case K_SYSCALL_BATCH_POLL_SIGNAL_RAISE:
+		return z_impl_k_poll_signal_raise(entry->obj, (int)entry->value);
+#endif /* CONFIG_POLL */
+	default:
+		return -EINVAL;
+	}
+}
+
+int z_impl_k_syscall_batch(struct k_syscall_batch_entry *entries, size_t num)
+{
+	int failed = 0;
+
+	for (size_t i = 0; i < num; i++) {
+		entries[i].result = batch_entry_run(&entries[i]);
+		if (entries[i].result != 0) {
+			failed++;
+		}
+	}
+
+	return failed;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Validate an entry, return false if the operation is unknown. Every entry
+ * is validated on its own: the batch may be preempted, or block, between
+ * entries, and permissions revoked or objects freed meanwhile.
+ */
+static bool batch_entry_check(const struct k_syscall_batch_entry *entry)
+{
+	struct k_msgq *msgq;
+
+	switch (entry->op) {
+	case K_SYSCALL_BATCH_SEM_GIVE:
+	case K_SYSCALL_BATCH_SEM_TAKE:
+		K_OOPS(K_SYSCALL_OBJ(entry->obj, K_OBJ_SEM));
+		return true;
+	case K_SYSCALL_BATCH_MSGQ_PUT:
+		K_OOPS(K_SYSCALL_OBJ(entry->obj, K_OBJ_MSGQ));
+		msgq = entry->obj;
+		K_OOPS(K_SYSCALL_MEMORY_READ(entry->data, msgq->msg_size));
+		return true;
+	case K_SYSCALL_BATCH_MSGQ_GET:
+		K_OOPS(K_SYSCALL_OBJ(entry->obj, K_OBJ_MSGQ));
+		msgq = entry->obj;
+		K_OOPS(K_SYSCALL_MEMORY_WRITE(entry->data, msgq->msg_size));
+		return true;
+#ifdef CONFIG_EVENTS
+	case K_SYSCALL_BATCH_EVENT_POST:
+	case K_SYSCALL_BATCH_EVENT_SET:
+		K_OOPS(K_SYSCALL_OBJ(entry->obj, K_OBJ_EVENT));
+		return true;
+#endif /* CONFIG_EVENTS */
+#ifdef CONFIG_POLL
+	case K_SYSCALL_BATCH_POLL_SIGNAL_RAISE:
+		K_OOPS(K_SYSCALL_OBJ(entry->obj, K_OBJ_POLL_SIGNAL));
+		return true;
+#endif /* CONFIG_POLL */
+	default:
+		return false;
+	}
+}
+
+static inline int z_vrfy_k_syscall_batch(struct k_syscall_batch_entry *entries, size_t num)
+{
+	struct k_syscall_batch_entry entry;
+	int failed = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(entries, num, sizeof(*entries)));
+
+	for (size_t i = 0; i < num; i++) {
+		/* Entries are fetched once, the caller may change them meanwhile */
+		memcpy(&entry, &entries[i], sizeof(entry));
+
+		if (batch_entry_check(&entry)) {
+			entry.result = batch_entry_run(&entry);
+		} else {
+			entry.result = -EINVAL;
+		}
+
+		entries[i].result = entry.result;
+		entries[i].value = entry.value;
+		if (entry.result != 0) {
+			failed++;
+		}
+	}
+
+	return failed;
+}
+#include <zephyr/syscalls/k_syscall_batch_mrsh.c>
+#endif /* CONFIG_USERSPACE */
@@ -13,25 +13,77 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
+#include <zephyr/sys/printk.h>
+#include <kernel_internal.h>
 
 static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
 			     CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
 
 struct k_work_q k_sys_work_q;
 
+#ifdef CONFIG_SYSTEM_WORKQUEUE_PER_CPU
+/* k_sys_work_q serves CPU 0, these serve the other CPUs */
+static K_KERNEL_STACK_ARRAY_DEFINE(sys_work_q_cpu_stacks,
+				   CONFIG_MP_MAX_NUM_CPUS - 1,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+
+static struct k_work_q sys_work_q_cpu[CONFIG_MP_MAX_NUM_CPUS - 1];
+
+struct k_work_q *z_sys_work_q_local(void)
+{
+	unsigned int cpu = arch_curr_cpu()->id;
+
+	if (cpu == 0U) {
+		return &k_sys_work_q;
+	}
+
+	/* The queues are started before the secondary CPUs, but be
+	 * safe against submissions from a CPU brought up early.
+	 */
+	struct k_work_q *queue = &sys_work_q_cpu[cpu - 1U];
+
+	if ((queue->flags & K_WORK_QUEUE_STARTED) == 0U) {
+		return &k_sys_work_q;
+	}
+
+	return queue;
+}
+#endif /* CONFIG_SYSTEM_WORKQUEUE_PER_CPU */
+
 static int k_sys_work_q_init(void)
 {
-	static const struct k_work_queue_config cfg = {
+	struct k_work_queue_config cfg = {
 		.name = "sysworkq",
 		.no_yield = IS_ENABLED(CONFIG_SYSTEM_WORKQUEUE_NO_YIELD),
 		.essential = true,
 		.work_timeout_ms = CONFIG_SYSTEM_WORKQUEUE_WORK_TIMEOUT_MS,
 	};
 
+#ifdef CONFIG_SYSTEM_WORKQUEUE_PER_CPU
+	cfg.cpu_mask = BIT(0);
+#endif /* CONFIG_SYSTEM_WORKQUEUE_PER_CPU */
+
 	k_work_queue_start(&k_sys_work_q,
 			    sys_work_q_stack,
 			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+
+#ifdef CONFIG_SYSTEM_WORKQUEUE_PER_CPU
+	for (unsigned int cpu = 1; cpu < arch_num_cpus(); cpu++) {
+		char name[16];
+
+		/* The name is copied into the thread */
+		snprintk(name, sizeof(name), "sysworkq%u", cpu);
+		cfg.name = name;
+		cfg.cpu_mask = BIT(cpu);
+
+		k_work_queue_start(&sys_work_q_cpu[cpu - 1U],
+				   sys_work_q_cpu_stacks[cpu - 1U],
+				   K_KERNEL_STACK_SIZEOF(sys_work_q_cpu_stacks[cpu - 1U]),
+				   CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+	}
+#endif /* CONFIG_SYSTEM_WORKQUEUE_PER_CPU */
+
 	return 0;
 }
 
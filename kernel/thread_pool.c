@@ -0,0 +1,148 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/thread_pool.h>
+#include <kernel_internal.h>
+
+/*
+ * Pool threads loop on their job queue, the job being copied to their own
+ * stack. What an entry point may leave in the thread state is cleared before
+ * the thread is parked, so that spawning does not pay for it.
+ */
+static void thread_pool_worker(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *jobs = p1;
+	struct k_sem *done = p2;
+	struct k_thread_pool_job job;
+
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		(void)k_msgq_get(jobs, &job, K_FOREVER);
+		job.entry(job.p1, job.p2, job.p3);
+
+#ifdef CONFIG_ERRNO
+		errno = 0;
+#endif /* CONFIG_ERRNO */
+#ifdef CONFIG_THREAD_CUSTOM_DATA
+		k_thread_custom_data_set(NULL);
+#endif /* CONFIG_THREAD_CUSTOM_DATA */
+
+		k_sem_give(done);
+	}
+}
+
+static void thread_pool_create(struct k_thread_pool *pool, size_t idx, int prio)
+{
+	struct k_thread_pool_worker *worker = &pool->workers[idx];
+	struct k_thread *thread = &pool->threads[idx];
+	k_thread_stack_t *stack = (k_thread_stack_t *)((uint8_t *)pool->stacks +
+						       (idx * pool->stack_len));
+
+	k_msgq_init(&worker->jobs, (char *)&worker->job_buf, sizeof(worker->job_buf), 1);
+	k_sem_init(&worker->done, 0, 1);
+
+	(void)k_thread_create(thread, stack, pool->stack_size, thread_pool_worker,
+			      &worker->jobs, &worker->done, NULL, prio, pool->options,
+			      K_NO_WAIT);
+}
+
+/* Give a parked thread the context k_thread_create() would give a new one */
+static void thread_pool_reset(struct k_thread_pool *pool, size_t idx, int prio)
+{
+	struct k_thread *thread = &pool->threads[idx];
+
+#ifdef CONFIG_USERSPACE
+	int ret;
+
+	ret = k_mem_domain_add_thread(_current->mem_domain_info.mem_domain, thread);
+	__ASSERT_NO_MSG(ret == 0);
+	ARG_UNUSED(ret);
+#endif /* CONFIG_USERSPACE */
+
+	k_thread_priority_set(thread, prio);
+}
+
+k_tid_t k_thread_pool_spawn(struct k_thread_pool *pool, k_thread_entry_t entry,
+			    void *p1, void *p2, void *p3, int prio, k_timeout_t timeout)
+{
+	struct k_thread_pool_job job = {
+		.entry = entry,
+		.p1 = p1,
+		.p2 = p2,
+		.p3 = p3,
+	};
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+	size_t idx;
+	int ret;
+
+	__ASSERT(!k_is_in_isr(), "thread pools may not be used from ISRs");
+	__ASSERT(entry != NULL, "no entry point");
+
+	/* Counts the threads parked or not created yet */
+	if (k_sem_take(&pool->avail, timeout) != 0) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&pool->lock);
+	node = sys_slist_get(&pool->idle);
+	if (node != NULL) {
+		idx = CONTAINER_OF(node, struct k_thread_pool_worker, node) - pool->workers;
+	} else {
+		__ASSERT_NO_MSG(pool->num_created < pool->num_threads);
+		idx = pool->num_created++;
+	}
+	k_spin_unlock(&pool->lock, key);
+
+	if (node != NULL) {
+		thread_pool_reset(pool, idx, prio);
+	} else {
+		thread_pool_create(pool, idx, prio);
+	}
+
+	ret = k_msgq_put(&pool->workers[idx].jobs, &job, K_NO_WAIT);
+	__ASSERT(ret == 0, "pool thread %zu is busy", idx);
+	ARG_UNUSED(ret);
+
+	return &pool->threads[idx];
+}
+
+int k_thread_pool_join(struct k_thread_pool *pool, k_tid_t thread, k_timeout_t timeout)
+{
+	struct k_thread_pool_worker *worker;
+	k_spinlock_key_t key;
+	size_t num_created;
+	size_t idx;
+	int ret;
+
+	key = k_spin_lock(&pool->lock);
+	num_created = pool->num_created;
+	k_spin_unlock(&pool->lock, key);
+
+	if ((thread < pool->threads) || (thread >= &pool->threads[num_created])) {
+		return -EINVAL;
+	}
+
+	idx = thread - pool->threads;
+	worker = &pool->workers[idx];
+
+	ret = k_sem_take(&worker->done, timeout);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Most recently used threads first, their stack is more likely cached */
+	key = k_spin_lock(&pool->lock);
+	sys_slist_prepend(&pool->idle, &worker->node);
+	k_spin_unlock(&pool->lock, key);
+
+	k_sem_give(&pool->avail);
+
+	return 0;
+}
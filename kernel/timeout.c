@@ -11,11 +11,14 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/llext/symbol.h>
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
 
 /*
  * The timeout code shall take no locks other than its own (timeout_lock), nor
@@ -38,6 +41,300 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+static int32_t elapsed(void)
+{
+	/* While sys_clock_announce() is executing, new relative timeouts will be
+	 * scheduled relatively to the currently firing timeout's original tick
+	 * value (=curr_tick) rather than relative to the current
+	 * sys_clock_elapsed().
+	 *
+	 * This means that timeouts being scheduled from within timeout callbacks
+	 * will be scheduled at well-defined offsets from the currently firing
+	 * timeout.
+	 *
+	 * As a side effect, the same will happen if an ISR with higher priority
+	 * preempts a timeout callback and schedules a timeout.
+	 *
+	 * The distinction is implemented by looking at announce_remaining which
+	 * will be non-zero while sys_clock_announce() is executing and zero
+	 * otherwise.
+	 */
+	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_BITS   CONFIG_TIMEOUT_WHEEL_SLOT_BITS
+#define WHEEL_SLOTS  BIT(WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SLOTS - 1U)
+
+/*
+ * Hierarchical timing wheel.  Timeouts store their absolute expiry, in
+ * wheel ticks, in dticks.  Wheel ticks advance in lockstep with
+ * curr_tick but start at zero, so sys_clock_tick_set() can move
+ * curr_tick without disturbing armed timeouts.
+ *
+ * A timeout expiring at tick E is kept at the lowest level L such that
+ * (E >> (L * WHEEL_BITS)) lies less than WHEEL_SLOTS slots ahead of the
+ * wheel position, in slot (E >> (L * WHEEL_BITS)) & WHEEL_MASK.  Level 0
+ * slots therefore hold timeouts expiring on one exact tick.  When the
+ * wheel enters a non-empty slot of a higher level, that slot is
+ * cascaded: its timeouts are reinserted and land in lower levels.
+ *
+ * A slot's list head is only valid while its bit is set in the level
+ * bitmap, which lets the heads live in .bss without a static
+ * initializer.
+ */
+static sys_dlist_t wheel_slots[WHEEL_LEVELS * WHEEL_SLOTS];
+static uint64_t wheel_bitmap[WHEEL_LEVELS];
+
+/* Lower bound of the expiries held in each slot above level 0.  Kept
+ * exact on insertion; aborts may leave it too low, which at worst
+ * costs one early wakeup at the slot boundary.
+ */
+static uint64_t wheel_min[WHEEL_LEVELS - 1][WHEEL_SLOTS];
+
+/* Timeouts too far ahead for the outermost level */
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+static uint64_t wheel_overflow_min;
+
+/* Wheel position, in wheel ticks.  Only ahead of curr_tick within
+ * sys_clock_announce() while the lock is held.
+ */
+static uint64_t wheel_tick;
+
+static inline unsigned int wheel_shift(unsigned int level)
+{
+	return level * WHEEL_BITS;
+}
+
+static inline sys_dlist_t *wheel_slot(unsigned int level, unsigned int idx)
+{
+	return &wheel_slots[(level * WHEEL_SLOTS) + idx];
+}
+
+/* Distance in slots from idx to the first non-empty slot, or -1 */
+static inline int wheel_slot_distance(uint64_t bitmap, unsigned int idx)
+{
+	uint64_t ahead = bitmap >> idx;
+
+	if (ahead != 0ULL) {
+		return u64_count_trailing_zeros(ahead);
+	}
+	if (bitmap != 0ULL) {
+		return WHEEL_SLOTS - idx + u64_count_trailing_zeros(bitmap);
+	}
+
+	return -1;
+}
+
+/* must be locked */
+static void wheel_insert(struct _timeout *to)
+{
+	uint64_t expiry = to->dticks;
+
+	for (unsigned int level = 0; level < WHEEL_LEVELS; level++) {
+		unsigned int shift = wheel_shift(level);
+
+		if (((expiry >> shift) - (wheel_tick >> shift)) < WHEEL_SLOTS) {
+			unsigned int idx = (expiry >> shift) & WHEEL_MASK;
+			sys_dlist_t *slot = wheel_slot(level, idx);
+
+			if ((wheel_bitmap[level] & BIT64(idx)) == 0ULL) {
+				sys_dlist_init(slot);
+				wheel_bitmap[level] |= BIT64(idx);
+				if (level > 0) {
+					wheel_min[level - 1][idx] = expiry;
+				}
+			} else if ((level > 0) && (expiry < wheel_min[level - 1][idx])) {
+				wheel_min[level - 1][idx] = expiry;
+			}
+
+			sys_dlist_append(slot, &to->node);
+			return;
+		}
+	}
+
+	if (sys_dlist_is_empty(&wheel_overflow) || (expiry < wheel_overflow_min)) {
+		wheel_overflow_min = expiry;
+	}
+	sys_dlist_append(&wheel_overflow, &to->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	sys_dnode_t *head = t->node.next;
+
+	/* A node whose neighbours are one and the same is alone on its
+	 * list, and that list is about to become empty.
+	 */
+	if ((head == t->node.prev) && PART_OF_ARRAY(wheel_slots, head)) {
+		size_t i = head - wheel_slots;
+
+		wheel_bitmap[i / WHEEL_SLOTS] &= ~BIT64(i % WHEEL_SLOTS);
+	}
+
+	sys_dlist_remove(&t->node);
+}
+
+/* must be locked
+ *
+ * Returns the wheel tick of the next point at which the wheel has work
+ * to do: the exact expiry of the earliest timeout on level 0, or the
+ * boundary of the next non-empty slot of a higher level.  With
+ * @a bound set, higher levels instead report the lower bound of the
+ * expiries in that slot, for programming the timer.
+ */
+static uint64_t wheel_next(bool bound)
+{
+	uint64_t ret = UINT64_MAX;
+
+	for (unsigned int level = 0; level < WHEEL_LEVELS; level++) {
+		unsigned int shift = wheel_shift(level);
+		unsigned int idx = (wheel_tick >> shift) & WHEEL_MASK;
+		int d = wheel_slot_distance(wheel_bitmap[level], idx);
+		uint64_t next;
+
+		if (d < 0) {
+			continue;
+		}
+
+		next = ((wheel_tick >> shift) + d) << shift;
+		if ((level > 0) && bound) {
+			next = max(next, wheel_min[level - 1][(idx + d) & WHEEL_MASK]);
+		}
+		ret = min(ret, next);
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		unsigned int shift = wheel_shift(WHEEL_LEVELS);
+		uint64_t next = ((wheel_tick >> shift) + 1) << shift;
+
+		if (bound) {
+			next = max(next, wheel_overflow_min);
+		}
+		ret = min(ret, next);
+	}
+
+	return ret;
+}
+
+/* must be locked */
+static void wheel_cascade(sys_dlist_t *list)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* must be locked
+ *
+ * Moves the wheel forward to tick, which must not be beyond
+ * wheel_next(false), cascading every slot entered on the way.
+ */
+static void wheel_advance(uint64_t tick)
+{
+	uint64_t prev = wheel_tick;
+
+	wheel_tick = tick;
+
+	if (!sys_dlist_is_empty(&wheel_overflow) &&
+	    ((tick >> wheel_shift(WHEEL_LEVELS)) != (prev >> wheel_shift(WHEEL_LEVELS)))) {
+		struct _timeout *t, *tmp;
+
+		wheel_overflow_min = UINT64_MAX;
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&wheel_overflow, t, tmp, node) {
+			uint64_t expiry = t->dticks;
+			unsigned int shift = wheel_shift(WHEEL_LEVELS - 1);
+
+			if (((expiry >> shift) - (tick >> shift)) < WHEEL_SLOTS) {
+				sys_dlist_remove(&t->node);
+				wheel_insert(t);
+			} else {
+				wheel_overflow_min = min(wheel_overflow_min, expiry);
+			}
+		}
+	}
+
+	for (unsigned int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		unsigned int shift = wheel_shift(level);
+		unsigned int idx = (tick >> shift) & WHEEL_MASK;
+
+		if (((tick >> shift) != (prev >> shift)) &&
+		    ((wheel_bitmap[level] & BIT64(idx)) != 0ULL)) {
+			wheel_bitmap[level] &= ~BIT64(idx);
+			wheel_cascade(wheel_slot(level, idx));
+		}
+	}
+}
+
+/* must be locked
+ *
+ * Advances the wheel up to limit and returns the first timeout
+ * expiring at or before it, leaving the wheel at its expiry.
+ */
+static struct _timeout *wheel_expired(uint64_t limit)
+{
+	for (;;) {
+		unsigned int idx = wheel_tick & WHEEL_MASK;
+		uint64_t next;
+
+		if ((wheel_bitmap[0] & BIT64(idx)) != 0ULL) {
+			sys_dnode_t *node = sys_dlist_peek_head(wheel_slot(0, idx));
+
+			return CONTAINER_OF(node, struct _timeout, node);
+		}
+
+		next = wheel_next(false);
+		if (next > limit) {
+			return NULL;
+		}
+		wheel_advance(next);
+	}
+}
+
+static bool timeout_is_first(const struct _timeout *to)
+{
+	return (uint64_t)to->dticks == wheel_next(true);
+}
+
+static void insert_timeout(struct _timeout *to)
+{
+	to->dticks += wheel_tick;
+	wheel_insert(to);
+}
+
+static int32_t next_timeout(int32_t ticks_elapsed)
+{
+	uint64_t next = wheel_next(true);
+	int64_t ticks;
+	int32_t ret;
+
+	if (next == UINT64_MAX) {
+		return SYS_CLOCK_MAX_WAIT;
+	}
+
+	ticks = (int64_t)(next - wheel_tick) - ticks_elapsed;
+	if (ticks > (int64_t)INT_MAX) {
+		ret = SYS_CLOCK_MAX_WAIT;
+	} else {
+		ret = max(0, ticks);
+	}
+
+	return ret;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return timeout->dticks - wheel_tick;
+}
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -61,25 +358,28 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
+static bool timeout_is_first(const struct _timeout *to)
 {
-	/* While sys_clock_announce() is executing, new relative timeouts will be
-	 * scheduled relatively to the currently firing timeout's original tick
-	 * value (=curr_tick) rather than relative to the current
-	 * sys_clock_elapsed().
-	 *
-	 * This means that timeouts being scheduled from within timeout callbacks
-	 * will be scheduled at well-defined offsets from the currently firing
-	 * timeout.
-	 *
-	 * As a side effect, the same will happen if an ISR with higher priority
-	 * preempts a timeout callback and schedules a timeout.
-	 *
-	 * The distinction is implemented by looking at announce_remaining which
-	 * will be non-zero while sys_clock_announce() is executing and zero
-	 * otherwise.
-	 */
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+	return to == first();
+}
+
+/* must be locked; to->dticks is relative to curr_tick */
+static void insert_timeout(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
 }
 
 static int32_t next_timeout(int32_t ticks_elapsed)
@@ -97,6 +397,23 @@ static int32_t next_timeout(int32_t ticks_elapsed)
 	return ret;
 }
 
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
 {
 	k_ticks_t ticks = 0;
@@ -113,7 +430,6 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
 		int32_t ticks_elapsed;
 		bool has_elapsed = false;
 
@@ -129,20 +445,9 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 			ticks = timeout.ticks;
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to);
 
-		if (to == first() && announce_remaining == 0) {
+		if (timeout_is_first(to) && announce_remaining == 0) {
 			if (!has_elapsed) {
 				/* In case of absolute timeout that is first to expire
 				 * elapsed need to be read from the system clock.
@@ -162,7 +467,7 @@ int z_abort_timeout(struct _timeout *to)
 
 	K_SPINLOCK(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
+			bool is_first = timeout_is_first(to);
 
 			remove_timeout(to);
 			to->dticks = TIMEOUT_DTICKS_ABORTED;
@@ -176,21 +481,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -250,6 +540,27 @@ void sys_clock_announce(int32_t ticks)
 
 	struct _timeout *t;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t now = wheel_tick;
+
+	for (t = wheel_expired(now + announce_remaining);
+	     t != NULL;
+	     t = wheel_expired(now + announce_remaining)) {
+		int dt = t->dticks - now;
+
+		now += dt;
+		curr_tick += dt;
+		t->dticks = 0;
+		remove_timeout(t);
+
+		k_spin_unlock(&timeout_lock, key);
+		t->fn(t);
+		key = k_spin_lock(&timeout_lock);
+		announce_remaining -= dt;
+	}
+
+	wheel_tick = now + announce_remaining;
+#else
 	for (t = first();
 	     (t != NULL) && (t->dticks <= announce_remaining);
 	     t = first()) {
@@ -268,6 +579,7 @@ void sys_clock_announce(int32_t ticks)
 	if (t != NULL) {
 		t->dticks -= announce_remaining;
 	}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -16,6 +16,7 @@
 #include <zephyr/spinlock.h>
 #include <errno.h>
 #include <ksched.h>
+#include <kernel_internal.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/logging/log.h>
 
@@ -252,13 +253,17 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
  *
  * @param work to be submitted
  *
+ * @param notify whether to notify the queue.  If false the caller is
+ * responsible for calling notify_queue_locked() before releasing the lock.
+ *
  * @retval 1 if successfully queued
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
  * @retval -EBUSY if the submission was rejected (draining, plugged)
  */
 static inline int queue_submit_locked(struct k_work_q *queue,
-				      struct k_work *work)
+				      struct k_work *work,
+				      bool notify)
 {
 	if (queue == NULL) {
 		return -EINVAL;
@@ -285,7 +290,9 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
-		(void)notify_queue_locked(queue);
+		if (notify) {
+			(void)notify_queue_locked(queue);
+		}
 	}
 
 	return ret;
@@ -309,6 +316,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * the queue it was submitted to.  That may or may not be the queue provided
  * on input.
  *
+ * @param notify passed to queue_submit_locked().
+ *
  * @retval 0 if work was already submitted to a queue
  * @retval 1 if work was not submitted and has been queued to @p queue
  * @retval 2 if work was running and has been queued to the queue that was
@@ -317,8 +326,9 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
  */
-static int submit_to_queue_locked(struct k_work *work,
-				  struct k_work_q **queuep)
+static int submit_locked(struct k_work *work,
+			 struct k_work_q **queuep,
+			 bool notify)
 {
 	int ret = 0;
 
@@ -345,7 +355,7 @@ static int submit_to_queue_locked(struct k_work *work,
 			ret = 2;
 		}
 
-		int rc = queue_submit_locked(*queuep, work);
+		int rc = queue_submit_locked(*queuep, work, notify);
 
 		if (rc < 0) {
 			ret = rc;
@@ -364,6 +374,18 @@ static int submit_to_queue_locked(struct k_work *work,
 	return ret;
 }
 
+/* Attempt to submit work to a queue, notifying the queue.
+ *
+ * Invoked with work lock held.
+ *
+ * See submit_locked().
+ */
+static inline int submit_to_queue_locked(struct k_work *work,
+					 struct k_work_q **queuep)
+{
+	return submit_locked(work, queuep, true);
+}
+
 /* Submit work to a queue but do not yield the current thread.
  *
  * Intended for internal use.
@@ -415,13 +437,63 @@ int k_work_submit(struct k_work *work)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, submit, work);
 
-	int ret = k_work_submit_to_queue(&k_sys_work_q, work);
+	int ret = k_work_submit_to_queue(z_sys_work_q_local(), work);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, submit, work, ret);
 
 	return ret;
 }
 
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work *const *work, size_t count)
+{
+	__ASSERT_NO_MSG((work != NULL) || (count == 0U));
+
+	struct k_work_q *notify = NULL;
+	bool resched = false;
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < count; i++) {
+		struct k_work_q *target = queue;
+
+		__ASSERT_NO_MSG(work[i] != NULL);
+		__ASSERT_NO_MSG(work[i]->handler != NULL);
+
+		int rc = submit_locked(work[i], &target, false);
+
+		if (rc >= 0) {
+			ret++;
+		}
+
+		/* Items normally all land on the same queue, but a NULL
+		 * queue or an item still running elsewhere can redirect
+		 * them: notify each queue once the run of items going to
+		 * it ends.
+		 */
+		if ((target != NULL) && (target != notify)) {
+			resched |= notify_queue_locked(notify);
+			notify = target;
+		}
+	}
+
+	resched |= notify_queue_locked(notify);
+
+	k_spin_unlock(&lock, key);
+
+	/* See k_work_submit_to_queue() */
+	if (resched) {
+		z_reschedule_unlocked();
+	}
+
+	return ret;
+}
+
+int k_work_submit_batch(struct k_work *const *work, size_t count)
+{
+	return k_work_submit_batch_to_queue(z_sys_work_q_local(), work, count);
+}
+
 /* Flush the work item if necessary.
  *
  * Flushing is necessary only if the work is either queued or running.
@@ -849,6 +921,17 @@ void k_work_queue_start(struct k_work_q *queue,
 		queue->thread.base.user_options |= K_ESSENTIAL;
 	}
 
+#if defined(CONFIG_SCHED_CPU_MASK)
+	if ((cfg != NULL) && (cfg->cpu_mask != 0U)) {
+		(void)k_thread_cpu_mask_clear(&queue->thread);
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+			if ((cfg->cpu_mask & BIT(cpu)) != 0U) {
+				(void)k_thread_cpu_mask_enable(&queue->thread, cpu);
+			}
+		}
+	}
+#endif /* defined(CONFIG_SCHED_CPU_MASK) */
+
 #if defined(CONFIG_WORKQUEUE_WORK_TIMEOUT)
 	if ((cfg != NULL) && (cfg->work_timeout_ms)) {
 		queue->work_timeout = K_MSEC(cfg->work_timeout_ms);
@@ -1133,7 +1216,7 @@ int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, schedule, dwork, delay);
 
-	int ret = k_work_schedule_for_queue(&k_sys_work_q, dwork, delay);
+	int ret = k_work_schedule_for_queue(z_sys_work_q_local(), dwork, delay);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, schedule, dwork, delay, ret);
 
@@ -1168,7 +1251,7 @@ int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, reschedule, dwork, delay);
 
-	int ret = k_work_reschedule_for_queue(&k_sys_work_q, dwork, delay);
+	int ret = k_work_reschedule_for_queue(z_sys_work_q_local(), dwork, delay);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, reschedule, dwork, delay, ret);
 
@@ -133,13 +133,13 @@ static void merge_chunks(struct z_heap *h, chunkid_t lc, chunkid_t rc)
 static void free_chunk(struct z_heap *h, chunkid_t c)
 {
 	/* Merge with free right chunk? */
-	if (!chunk_used(h, right_chunk(h, c))) {
+	if (!chunk_used(h, right_chunk(h, c)) && !chunk_cached(h, right_chunk(h, c))) {
 		free_list_remove(h, right_chunk(h, c));
 		merge_chunks(h, c, right_chunk(h, c));
 	}
 
 	/* Merge with free left chunk? */
-	if (!chunk_used(h, left_chunk(h, c))) {
+	if (!chunk_used(h, left_chunk(h, c)) && !chunk_cached(h, left_chunk(h, c))) {
 		free_list_remove(h, left_chunk(h, c));
 		merge_chunks(h, left_chunk(h, c), c);
 		c = left_chunk(h, c);
@@ -148,6 +148,102 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+/* Size-class front-end.  Small chunks being freed are marked cached
+ * (see chunk_cached()), pushed on the list of their exact size and
+ * popped again by allocations of that size, so the common small
+ * alloc/free cycle never splits, merges or searches the buckets.
+ */
+static chunkid_t size_class_get(struct z_heap *h, chunksz_t sz)
+{
+	if (sz > CONFIG_SYS_HEAP_SIZE_CLASS_COUNT) {
+		return 0;
+	}
+
+	chunkid_t c = h->size_class_head[sz - 1];
+
+	if (c != 0U) {
+		CHECK(chunk_cached(h, c) && chunk_size(h, c) == sz);
+		h->size_class_head[sz - 1] = next_free_chunk(h, c);
+		h->size_class_count[sz - 1]--;
+		set_chunk_used(h, c, true);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		h->cached_bytes -= chunksz_to_bytes(h, sz);
+#endif
+	}
+
+	return c;
+}
+
+static bool size_class_put(struct z_heap *h, chunkid_t c, chunksz_t sz)
+{
+	if ((sz > CONFIG_SYS_HEAP_SIZE_CLASS_COUNT) || solo_free_header(h, c) ||
+	    (h->size_class_count[sz - 1] >= CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH)) {
+		return false;
+	}
+
+	set_chunk_used(h, c, false);
+	set_prev_free_chunk(h, c, 0);
+	set_next_free_chunk(h, c, h->size_class_head[sz - 1]);
+	h->size_class_head[sz - 1] = c;
+	h->size_class_count[sz - 1]++;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->cached_bytes += chunksz_to_bytes(h, sz);
+#endif
+
+	return true;
+}
+
+/* Return all cached chunks to the heap.  Returns true if there were any. */
+static bool size_class_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASS_COUNT; i++) {
+		chunkid_t c = h->size_class_head[i];
+
+		while (c != 0U) {
+			chunkid_t next = next_free_chunk(h, c);
+
+			free_chunk(h, c);
+			c = next;
+			flushed = true;
+		}
+		h->size_class_head[i] = 0;
+		h->size_class_count[i] = 0;
+	}
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->cached_bytes = 0;
+#endif
+
+	return flushed;
+}
+#else
+static inline chunkid_t size_class_get(struct z_heap *h, chunksz_t sz)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(sz);
+
+	return 0;
+}
+
+static inline bool size_class_put(struct z_heap *h, chunkid_t c, chunksz_t sz)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(c);
+	ARG_UNUSED(sz);
+
+	return false;
+}
+
+static inline bool size_class_flush(struct z_heap *h)
+{
+	ARG_UNUSED(h);
+
+	return false;
+}
+#endif /* CONFIG_SYS_HEAP_SIZE_CLASS_CACHE */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -172,6 +268,8 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	 * This should catch many double-free cases.
 	 * This is cheap enough so let's do it all the time.
 	 */
+	__ASSERT(!chunk_cached(h, c),
+		 "double-free of cached memory at %p", mem);
 	__ASSERT(chunk_used(h, c),
 		 "unexpected heap state (double-free?) for memory at %p", mem);
 
@@ -184,16 +282,22 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
+	chunksz_t chunk_sz = chunk_size(h, c);
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+	h->allocated_bytes -= chunksz_to_bytes(h, chunk_sz);
 #endif
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
 	heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
-				  chunksz_to_bytes(h, chunk_size(h, c)));
+				  chunksz_to_bytes(h, chunk_sz));
 #endif
 
+	if (size_class_put(h, c, chunk_sz)) {
+		return;
+	}
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -270,29 +374,41 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes, 0);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = size_class_get(h, chunk_sz);
 
 	if (c == 0U) {
-		return NULL;
-	}
+		c = alloc_chunk(h, chunk_sz);
 
-	/* Split off remainder if any */
-	if (chunk_size(h, c) > chunk_sz) {
-		split_chunks(h, c, c + chunk_sz);
-		free_list_add(h, c + chunk_sz);
-	}
+		/* Under pressure, give the cached chunks back and retry */
+		if ((c == 0U) && size_class_flush(h)) {
+			c = alloc_chunk(h, chunk_sz);
+		}
 
-	set_chunk_used(h, c, true);
+		if (c == 0U) {
+			return NULL;
+		}
+
+		/* Split off remainder if any */
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
+
+		set_chunk_used(h, c, true);
+	}
 
 	mem = chunk_mem(h, c);
 
+	/* The chunk is exactly chunk_sz units now, no need to read it back
+	 * from its header.
+	 */
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-	increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, c)));
+	increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_sz));
 #endif
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
 	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
-				   chunksz_to_bytes(h, chunk_size(h, c)));
+				   chunksz_to_bytes(h, chunk_sz));
 #endif
 
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
@@ -343,6 +459,10 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes, align - gap);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+	if ((c0 == 0) && size_class_flush(h)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
+
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -425,7 +545,7 @@ static bool inplace_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 
 	chunkid_t rc = right_chunk(h, c);
 
-	if (!chunk_used(h, rc) &&
+	if (!chunk_used(h, rc) && !chunk_cached(h, rc) &&
 	    (chunk_size(h, c) + chunk_size(h, rc) >= chunks_need)) {
 		/* Expand: split the right chunk and append */
 		chunksz_t split_size = chunks_need - chunk_size(h, c);
@@ -555,6 +675,16 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->free_bytes = 0;
 	h->allocated_bytes = 0;
 	h->max_allocated_bytes = 0;
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+	h->cached_bytes = 0;
+#endif
+#endif
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASS_COUNT; i++) {
+		h->size_class_head[i] = 0;
+		h->size_class_count[i] = 0;
+	}
 #endif
 
 #if CONFIG_SYS_HEAP_ARRAY_SIZE
@@ -73,6 +73,16 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+	size_t cached_bytes;
+#endif
+#endif
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+	/* Size-class caches: singly linked through FREE_NEXT, the list at
+	 * index i holds cached chunks of exactly i + 1 units.
+	 */
+	chunkid_t size_class_head[CONFIG_SYS_HEAP_SIZE_CLASS_COUNT];
+	uint8_t size_class_count[CONFIG_SYS_HEAP_SIZE_CLASS_COUNT];
 #endif
 	struct z_heap_bucket buckets[];
 };
@@ -217,6 +227,24 @@ static inline bool solo_free_header(struct z_heap *h, chunkid_t c)
 	return big_heap(h) && (chunk_size(h, c) == 1U);
 }
 
+/* Chunks held by the size-class cache are neither used nor on a free
+ * list, and must never be merged with their neighbors.  They are told
+ * apart from free chunks by a zero FREE_PREV link: chunk 0 holds the
+ * struct z_heap and is never on a free list.
+ */
+static inline bool chunk_cached(struct z_heap *h, chunkid_t c)
+{
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+	return !chunk_used(h, c) && !solo_free_header(h, c) &&
+	       (prev_free_chunk(h, c) == 0U);
+#else
+	ARG_UNUSED(h);
+	ARG_UNUSED(c);
+
+	return false;
+#endif
+}
+
 static inline size_t chunk_header_bytes(struct z_heap *h)
 {
 	return big_heap(h) ? 8 : 4;
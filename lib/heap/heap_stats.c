@@ -16,6 +16,9 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
 	}
 
 	stats->free_bytes = heap->heap->free_bytes;
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+	stats->free_bytes += heap->heap->cached_bytes;
+#endif
 	stats->allocated_bytes = heap->heap->allocated_bytes;
 	stats->max_allocated_bytes = heap->heap->max_allocated_bytes;
 
@@ -124,6 +124,8 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 
 	*result = (struct z_heap_stress_result) {0};
 
+	uint32_t start = k_cycle_get_32();
+
 	for (uint32_t i = 0; i < op_count; i++) {
 		if (rand_alloc_choice(&sr)) {
 			size_t sz = rand_alloc_size(&sr);
@@ -150,4 +152,6 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 		}
 		result->accumulated_in_use_bytes += sr.bytes_alloced;
 	}
+
+	result->elapsed_cycles = k_cycle_get_32() - start;
 }
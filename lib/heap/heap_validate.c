@@ -37,9 +37,9 @@ static bool valid_chunk(struct z_heap *h, chunkid_t c)
 	VALIDATE(left_chunk(h, right_chunk(h, c)) == c);
 	if (chunk_used(h, c)) {
 		VALIDATE(!solo_free_header(h, c));
-	} else {
-		VALIDATE(chunk_used(h, left_chunk(h, c)));
-		VALIDATE(chunk_used(h, right_chunk(h, c)));
+	} else if (!chunk_cached(h, c)) {
+		VALIDATE(chunk_used(h, left_chunk(h, c)) || chunk_cached(h, left_chunk(h, c)));
+		VALIDATE(chunk_used(h, right_chunk(h, c)) || chunk_cached(h, right_chunk(h, c)));
 		if (!solo_free_header(h, c)) {
 			VALIDATE(in_bounds(h, prev_free_chunk(h, c)));
 			VALIDATE(in_bounds(h, next_free_chunk(h, c)));
@@ -103,6 +103,29 @@ bool sys_heap_validate(struct sys_heap *heap)
 	}
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+	/* Size-class caches hold cached chunks of exactly their class size,
+	 * and no more of them than recorded.  Mark those chunks USED,
+	 * temporarily, so that the passes below treat them as allocated.
+	 */
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASS_COUNT; i++) {
+		uint32_t n = 0;
+
+		for (c = h->size_class_head[i]; c != 0; c = next_free_chunk(h, c)) {
+			if (!in_bounds(h, c) || !chunk_cached(h, c) ||
+			    (chunk_size(h, c) != i + 1) ||
+			    (++n > h->size_class_count[i])) {
+				return false;
+			}
+			set_chunk_used(h, c, true);
+		}
+
+		if (n != h->size_class_count[i]) {
+			return false;
+		}
+	}
+#endif
+
 	/* Check the free lists: entry count should match, empty bit
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
@@ -182,5 +205,14 @@ bool sys_heap_validate(struct sys_heap *heap)
 	for (c = right_chunk(h, 0); c < h->end_chunk; c = right_chunk(h, c)) {
 		set_chunk_used(h, c, !chunk_used(h, c));
 	}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASS_CACHE
+	/* Cached chunks came out of this as USED, they are not */
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASS_COUNT; i++) {
+		for (c = h->size_class_head[i]; c != 0; c = next_free_chunk(h, c)) {
+			set_chunk_used(h, c, false);
+		}
+	}
+#endif
 	return true;
 }
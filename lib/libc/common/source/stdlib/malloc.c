@@ -15,6 +15,7 @@
 #include <zephyr/sys/mutex.h>
 #endif
 #include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/multi_heap.h>
 #include <zephyr/sys/libc-hooks.h>
 #include <zephyr/types.h>
 #ifdef CONFIG_MMU
@@ -114,9 +115,196 @@ extern char _heap_sentry[];
 
 # endif /* else ALLOCATE_HEAP_AT_STARTUP */
 
+# if defined(CONFIG_COMMON_LIBC_MALLOC_ARENAS) && (CONFIG_COMMON_LIBC_MALLOC_ARENAS > 1)
+#  define MALLOC_ARENAS CONFIG_COMMON_LIBC_MALLOC_ARENAS
+# endif
+
+# ifdef MALLOC_ARENAS
+
+/*
+ * The malloc memory is split in MALLOC_ARENAS slices, each one a
+ * separately locked sys_heap, tied together by a sys_multi_heap which
+ * also maps freed pointers back to their arena.  Threads allocate from
+ * the arena of the CPU they run on (or of their thread hash), falling
+ * back to the others when it is exhausted.
+ *
+ * A block freed by a thread bound to another arena is not freed
+ * directly, as that would take the owner's lock: it is pushed on the
+ * owner's lock-free remote list instead (the link lives in the block
+ * itself), and the owner returns the whole batch to its heap the next
+ * time its lock is taken.  The list is only ever pushed to or swapped
+ * out as a whole, so there is no ABA problem.
+ */
+Z_LIBC_DATA static struct sys_heap z_malloc_arena_heap[MALLOC_ARENAS];
+Z_LIBC_DATA static struct sys_mutex z_malloc_arena_mutex[MALLOC_ARENAS];
+Z_LIBC_DATA static atomic_ptr_t z_malloc_arena_remote[MALLOC_ARENAS];
+Z_LIBC_DATA static struct sys_multi_heap z_malloc_mheap;
+
+/* Room for the remote free list link in every block */
+#  define MALLOC_MIN_SIZE sizeof(void *)
+
+static inline unsigned int malloc_arena_local(void)
+{
+#  ifdef CONFIG_COMMON_LIBC_MALLOC_ARENA_SELECT_CPU
+	/* Being migrated right after this is harmless, the arena choice
+	 * only matters for contention, not for correctness.
+	 */
+	return arch_curr_cpu()->id % MALLOC_ARENAS;
+#  else
+	/* Fibonacci hash of the thread pointer, dropping the low bits
+	 * that are always zero for an aligned struct k_thread.
+	 */
+	uint32_t h = (uint32_t)(POINTER_TO_UINT(k_current_get()) / sizeof(void *));
+
+	return ((h * 0x9E3779B1U) >> 16) % MALLOC_ARENAS;
+#  endif /* CONFIG_COMMON_LIBC_MALLOC_ARENA_SELECT_CPU */
+}
+
+static void malloc_arena_lock(unsigned int arena)
+{
+	int lock_ret;
+
+	lock_ret = sys_mutex_lock(&z_malloc_arena_mutex[arena], K_FOREVER);
+	__ASSERT_NO_MSG(lock_ret == 0);
+
+	/* Take back the blocks other arenas' threads freed meanwhile */
+	void *block = atomic_ptr_clear(&z_malloc_arena_remote[arena]);
+
+	while (block != NULL) {
+		void *next = *(void **)block;
+
+		sys_heap_free(&z_malloc_arena_heap[arena], block);
+		block = next;
+	}
+}
+
+static inline void malloc_arena_unlock(unsigned int arena)
+{
+	(void) sys_mutex_unlock(&z_malloc_arena_mutex[arena]);
+}
+
+static inline unsigned int malloc_arena_of(void *ptr)
+{
+	const struct sys_multi_heap_rec *rec =
+		sys_multi_heap_get_heap(&z_malloc_mheap, ptr);
+
+	__ASSERT(rec != NULL, "%p is not a malloc block", ptr);
+
+	return POINTER_TO_UINT(rec->user_data);
+}
+
+static void *malloc_arena_choice(struct sys_multi_heap *mheap, void *cfg,
+				 size_t align, size_t size)
+{
+	unsigned int local = POINTER_TO_UINT(cfg);
+	void *ret = NULL;
+
+	ARG_UNUSED(mheap);
+
+	for (unsigned int n = 0; (n < MALLOC_ARENAS) && (ret == NULL); n++) {
+		unsigned int arena = (local + n) % MALLOC_ARENAS;
+
+		malloc_arena_lock(arena);
+		ret = sys_heap_aligned_alloc(&z_malloc_arena_heap[arena],
+					     align, size);
+		malloc_arena_unlock(arena);
+	}
+
+	return ret;
+}
+
+static void *malloc_heap_alloc(size_t alignment, size_t size)
+{
+	if (size == 0) {
+		return NULL;
+	}
+
+	return sys_multi_heap_aligned_alloc(&z_malloc_mheap,
+					    UINT_TO_POINTER(malloc_arena_local()),
+					    alignment, MAX(size, MALLOC_MIN_SIZE));
+}
+
+static void malloc_heap_free(void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+	unsigned int arena = malloc_arena_of(ptr);
+
+	if (arena != malloc_arena_local()) {
+		void *head;
+
+		do {
+			head = atomic_ptr_get(&z_malloc_arena_remote[arena]);
+			*(void **)ptr = head;
+		} while (!atomic_ptr_cas(&z_malloc_arena_remote[arena], head, ptr));
+
+		return;
+	}
+
+	malloc_arena_lock(arena);
+	sys_heap_free(&z_malloc_arena_heap[arena], ptr);
+	malloc_arena_unlock(arena);
+}
+
+static void *malloc_heap_realloc(void *ptr, size_t alignment, size_t size)
+{
+	if (ptr == NULL) {
+		return malloc_heap_alloc(alignment, size);
+	}
+
+	if (size == 0) {
+		malloc_heap_free(ptr);
+		return NULL;
+	}
+
+	unsigned int arena = malloc_arena_of(ptr);
+	size_t old_size = 0;
+	void *ret;
+
+	size = MAX(size, MALLOC_MIN_SIZE);
+
+	/* Try to stay in the owning arena first, in place if possible */
+	malloc_arena_lock(arena);
+	ret = sys_heap_aligned_realloc(&z_malloc_arena_heap[arena], ptr,
+				       alignment, size);
+	if (ret == NULL) {
+		old_size = sys_heap_usable_size(&z_malloc_arena_heap[arena], ptr);
+	}
+	malloc_arena_unlock(arena);
+
+	if (ret == NULL) {
+		ret = malloc_heap_alloc(alignment, size);
+		if (ret != NULL) {
+			memcpy(ret, ptr, MIN(old_size, size));
+			malloc_heap_free(ptr);
+		}
+	}
+
+	return ret;
+}
+
+static void malloc_heap_init(void *heap_base, size_t heap_size)
+{
+	size_t arena_size = ROUND_DOWN(heap_size / MALLOC_ARENAS, sizeof(void *));
+
+	sys_multi_heap_init(&z_malloc_mheap, malloc_arena_choice);
+
+	for (unsigned int i = 0; i < MALLOC_ARENAS; i++) {
+		sys_mutex_init(&z_malloc_arena_mutex[i]);
+		sys_heap_init(&z_malloc_arena_heap[i],
+			      (uint8_t *)heap_base + i * arena_size, arena_size);
+		sys_multi_heap_add_heap(&z_malloc_mheap, &z_malloc_arena_heap[i],
+					UINT_TO_POINTER(i));
+	}
+}
+
+# else /* MALLOC_ARENAS */
+
 Z_LIBC_DATA static struct sys_heap z_malloc_heap;
 
-#ifdef CONFIG_MULTITHREADING
+#  ifdef CONFIG_MULTITHREADING
 Z_LIBC_DATA SYS_MUTEX_DEFINE(z_malloc_heap_mutex);
 
 static inline void
@@ -132,39 +320,65 @@ malloc_unlock(void)
 {
 	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
 }
-#else
-#define malloc_lock()
-#define malloc_unlock()
-#endif
+#  else
+#   define malloc_lock()
+#   define malloc_unlock()
+#  endif
 
-void *malloc(size_t size)
+static void *malloc_heap_alloc(size_t alignment, size_t size)
 {
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
-	if (ret == NULL && size != 0) {
-		errno = ENOMEM;
-	}
+	void *ret = sys_heap_aligned_alloc(&z_malloc_heap, alignment, size);
 
 	malloc_unlock();
 
 	return ret;
 }
 
-void *aligned_alloc(size_t alignment, size_t size)
+static void malloc_heap_free(void *ptr)
 {
 	malloc_lock();
+	sys_heap_free(&z_malloc_heap, ptr);
+	malloc_unlock();
+}
+
+static void *malloc_heap_realloc(void *ptr, size_t alignment, size_t size)
+{
+	malloc_lock();
+
+	void *ret = sys_heap_aligned_realloc(&z_malloc_heap, ptr, alignment, size);
+
+	malloc_unlock();
+
+	return ret;
+}
+
+static void malloc_heap_init(void *heap_base, size_t heap_size)
+{
+	sys_heap_init(&z_malloc_heap, heap_base, heap_size);
+}
+
+# endif /* else MALLOC_ARENAS */
+
+void *malloc(size_t size)
+{
+	void *ret = malloc_heap_alloc(__alignof__(z_max_align_t), size);
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   alignment,
-					   size);
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
 
-	malloc_unlock();
+	return ret;
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+	void *ret = malloc_heap_alloc(alignment, size);
+
+	if (ret == NULL && size != 0) {
+		errno = ENOMEM;
+	}
 
 	return ret;
 }
@@ -233,33 +447,26 @@ static int malloc_prepare(void)
 	z_malloc_partition.attr = K_MEM_PARTITION_P_RW_U_RW;
 #endif
 
-	sys_heap_init(&z_malloc_heap, heap_base, heap_size);
+	malloc_heap_init(heap_base, heap_size);
 
 	return 0;
 }
 
 void *realloc(void *ptr, size_t requested_size)
 {
-	malloc_lock();
-
-	void *ret = sys_heap_aligned_realloc(&z_malloc_heap, ptr,
-					     __alignof__(z_max_align_t),
-					     requested_size);
+	void *ret = malloc_heap_realloc(ptr, __alignof__(z_max_align_t),
+					requested_size);
 
 	if (ret == NULL && requested_size != 0) {
 		errno = ENOMEM;
 	}
 
-	malloc_unlock();
-
 	return ret;
 }
 
 void free(void *ptr)
 {
-	malloc_lock();
-	sys_heap_free(&z_malloc_heap, ptr);
-	malloc_unlock();
+	malloc_heap_free(ptr);
 }
 
 SYS_INIT(malloc_prepare, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_LIBC);
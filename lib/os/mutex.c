@@ -8,6 +8,9 @@
 #include <zephyr/sys/mutex.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
+#ifdef CONFIG_SYS_MUTEX_FAST
+#include <kernel_internal.h>
+#endif
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -23,9 +26,10 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* Without CONFIG_SYS_MUTEX_FAST, sys_mutex memory is never
+	 * touched, just used to lookup the underlying k_mutex.  Either
+	 * way we don't want threads using mutexes that are outside their
+	 * memory domain.
 	 */
 	return K_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
@@ -38,7 +42,14 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	/* The kernel mutex only serves as wait queue and priority
+	 * inheritance state, ownership is in the futex word.
+	 */
+	return z_futex_lock_pi(&mutex->val, kernel_mutex, timeout);
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,11 +67,19 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
+
+	return z_futex_unlock_pi(&mutex->val, kernel_mutex);
+#else
 	if ((kernel_mutex == NULL) || (kernel_mutex->lock_count == 0)) {
 		return -EINVAL;
 	}
 
 	return k_mutex_unlock(kernel_mutex);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
@@ -72,3 +91,61 @@ static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 	return z_impl_z_sys_mutex_kernel_unlock(mutex);
 }
 #include <zephyr/syscalls/z_sys_mutex_kernel_unlock_mrsh.c>
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+#if defined(CONFIG_SYS_MUTEX_SPIN_COUNT) && (CONFIG_SYS_MUTEX_SPIN_COUNT > 0)
+/* arch_spin_relax() expects interrupts masked, user threads can only idle */
+static inline void sys_mutex_spin_relax(void)
+{
+	if (k_is_user_context()) {
+		arch_nop();
+	} else {
+		unsigned int key = arch_irq_lock();
+
+		arch_spin_relax();
+		arch_irq_unlock(key);
+	}
+}
+#endif
+
+/* Runs in the caller's mode, user or supervisor */
+int z_sys_mutex_lock_contended(struct sys_mutex *mutex, k_timeout_t timeout)
+{
+	int ret;
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+#if defined(CONFIG_SYS_MUTEX_SPIN_COUNT) && (CONFIG_SYS_MUTEX_SPIN_COUNT > 0)
+	/* The owner may be about to release the mutex on another CPU:
+	 * retry for a little while before paying for a syscall and a
+	 * context switch, unless others are already blocked, in which
+	 * case the kernel hands the mutex over to them anyway.
+	 */
+	atomic_val_t self = (atomic_val_t)k_current_get();
+
+	for (int i = 0; i < CONFIG_SYS_MUTEX_SPIN_COUNT; i++) {
+		atomic_val_t val = atomic_get(&mutex->val);
+
+		if ((val & SYS_MUTEX_WAITERS) != 0) {
+			break;
+		}
+
+		if ((val == 0) && atomic_cas(&mutex->val, 0, self)) {
+			mutex->lock_count = 1U;
+			return 0;
+		}
+
+		sys_mutex_spin_relax();
+	}
+#endif
+
+	ret = z_sys_mutex_kernel_lock(mutex, timeout);
+	if (ret == 0) {
+		mutex->lock_count = 1U;
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
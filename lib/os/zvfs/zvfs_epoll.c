@@ -0,0 +1,491 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+
+/* POLL_PREPARE fills at most one event for input and one for output */
+#define ZVFS_EPOLL_PEV_PER_FD 2
+
+/* Events fetched at once from the poll set by zvfs_epoll_wait() */
+#define ZVFS_EPOLL_WAIT_BATCH 8
+
+#define ZVFS_EPOLL_ALWAYS_REPORTED (ZVFS_EPOLLERR | ZVFS_EPOLLHUP)
+
+struct zvfs_epoll_item {
+	/* on the always-ready list of the instance */
+	sys_dnode_t always_node;
+	/* on the ready list of the zvfs_epoll_wait() round handling the item */
+	sys_dnode_t ready_node;
+	int fd;
+	/* events reported last, the item is registered again when they change */
+	uint32_t revents;
+	uint8_t num_pev;
+	/* re-arming failed, reported with EPOLLERR until modified or removed */
+	bool failed;
+	struct zvfs_epoll_event event;
+	struct k_poll_event pev[ZVFS_EPOLL_PEV_PER_FD];
+};
+
+struct zvfs_epoll {
+	struct k_poll_set set;
+	/* protects the interest list, taken before any descriptor lock */
+	struct k_mutex lock;
+	struct zvfs_epoll_item items[CONFIG_ZVFS_EPOLL_MAX_FDS];
+	/* items POLL_PREPARE found ready without anything to wait on */
+	sys_dlist_t always_ready;
+	bool in_use;
+};
+
+SYS_BITARRAY_DEFINE_STATIC(epolls_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll epolls[CONFIG_ZVFS_EPOLL_MAX];
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+static struct zvfs_epoll_item *zvfs_epoll_find(struct zvfs_epoll *ep, int fd)
+{
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		if (ep->items[i].fd == fd) {
+			return &ep->items[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct zvfs_epoll_item *zvfs_epoll_item_of(struct zvfs_epoll *ep,
+						  struct k_poll_event *pev)
+{
+	size_t idx = ((uintptr_t)pev - (uintptr_t)ep->items) / sizeof(ep->items[0]);
+
+	__ASSERT_NO_MSG(idx < ARRAY_SIZE(ep->items));
+
+	return &ep->items[idx];
+}
+
+static void zvfs_epoll_set_always_ready(struct zvfs_epoll *ep, struct zvfs_epoll_item *item,
+					bool always_ready)
+{
+	if (sys_dnode_is_linked(&item->always_node) == always_ready) {
+		return;
+	}
+
+	if (always_ready) {
+		sys_dlist_append(&ep->always_ready, &item->always_node);
+	} else {
+		sys_dlist_remove(&item->always_node);
+	}
+}
+
+/* Register the kernel objects backing item->fd in the poll set */
+static int zvfs_epoll_arm(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = (short)item->event.events,
+	};
+	struct k_poll_event *pev = item->pev;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      item->pev + ARRAY_SIZE(item->pev));
+	k_mutex_unlock(lock);
+
+	if (ret == -EXDEV) {
+		/* Offloaded sockets have no kernel object to register */
+		errno = EPERM;
+		return -1;
+	} else if (ret < 0 && ret != -EALREADY) {
+		if (ret != -1) {
+			errno = -ret;
+		}
+		return -1;
+	}
+
+	item->num_pev = pev - item->pev;
+	zvfs_epoll_set_always_ready(ep, item, ret == -EALREADY);
+
+	for (int i = 0; i < item->num_pev; i++) {
+		k_poll_set_add(&ep->set, &item->pev[i]);
+	}
+
+	return 0;
+}
+
+static void zvfs_epoll_disarm(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	for (int i = 0; i < item->num_pev; i++) {
+		k_poll_set_remove(&ep->set, &item->pev[i]);
+	}
+
+	item->num_pev = 0;
+	item->revents = 0U;
+	item->failed = false;
+	zvfs_epoll_set_always_ready(ep, item, false);
+}
+
+static void zvfs_epoll_drop(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	zvfs_epoll_disarm(ep, item);
+	item->fd = -1;
+}
+
+static uint32_t zvfs_epoll_revents(struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = (short)item->event.events,
+	};
+	struct k_poll_event *pev = item->pev;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL) {
+		return 0;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		/* -EAGAIN: the wakeup did not carry any data yet (e.g. TLS) */
+		return 0;
+	}
+
+	return (uint16_t)pfd.revents & (item->event.events | ZVFS_EPOLL_ALWAYS_REPORTED);
+}
+
+/* Store the events of a ready item, returns the number of events stored */
+static int zvfs_epoll_report(struct zvfs_epoll *ep, struct zvfs_epoll_item *item,
+			     struct zvfs_epoll_event *event)
+{
+	uint32_t revents = 0U;
+
+	if (!item->failed) {
+		revents = zvfs_epoll_revents(item);
+
+		/* The poll set reports the item again as long as its objects
+		 * are ready. Prepare it again only when its state changed, so
+		 * that the events follow the descriptor (e.g. a connecting TCP
+		 * socket), or when the wakeup did not carry anything.
+		 */
+		if (revents == 0U || revents != item->revents) {
+			zvfs_epoll_disarm(ep, item);
+			if (zvfs_epoll_arm(ep, item) < 0) {
+				/* Nothing to wait on anymore, keep reporting the
+				 * error like a descriptor in error state.
+				 */
+				item->failed = true;
+				zvfs_epoll_set_always_ready(ep, item, true);
+			}
+		}
+
+		item->revents = revents;
+	}
+
+	if (item->failed) {
+		revents |= ZVFS_EPOLLERR;
+	}
+
+	if (revents == 0U) {
+		return 0;
+	}
+
+	event->events = revents;
+	event->data = item->event.data;
+
+	return 1;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+	int err;
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		if (ep->items[i].fd >= 0) {
+			zvfs_epoll_drop(ep, &ep->items[i]);
+		}
+	}
+
+	ep->in_use = false;
+
+	k_mutex_unlock(&ep->lock);
+
+	err = sys_bitarray_free(&epolls_bitarray, 1, ep - epolls);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+void zvfs_epoll_close_fd(int fd)
+{
+	ARRAY_FOR_EACH_PTR(epolls, ep) {
+		struct zvfs_epoll_item *item;
+
+		if (!ep->in_use) {
+			continue;
+		}
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+		item = zvfs_epoll_find(ep, fd);
+		if (item != NULL) {
+			zvfs_epoll_drop(ep, item);
+		}
+
+		k_mutex_unlock(&ep->lock);
+	}
+}
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create(int flags)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if ((flags & ~ZVFS_EPOLL_CLOEXEC) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sys_bitarray_alloc(&epolls_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &epolls[offset];
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&epolls_bitarray, 1, offset);
+		return -1;
+	}
+
+	k_poll_set_init(&ep->set);
+	k_mutex_init(&ep->lock);
+	ARRAY_FOR_EACH_PTR(ep->items, item) {
+		*item = (struct zvfs_epoll_item){.fd = -1};
+	}
+	sys_dlist_init(&ep->always_ready);
+	ep->in_use = true;
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	struct zvfs_epoll_item *item;
+	struct zvfs_epoll *ep;
+	int ret = 0;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd < 0 || fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	item = zvfs_epoll_find(ep, fd);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			errno = EEXIST;
+			ret = -1;
+			break;
+		}
+
+		item = zvfs_epoll_find(ep, -1);
+		if (item == NULL) {
+			errno = ENOSPC;
+			ret = -1;
+			break;
+		}
+
+		item->fd = fd;
+		item->event = *event;
+		ret = zvfs_epoll_arm(ep, item);
+		if (ret < 0) {
+			item->fd = -1;
+		}
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		zvfs_epoll_disarm(ep, item);
+		item->event = *event;
+		ret = zvfs_epoll_arm(ep, item);
+		if (ret < 0) {
+			item->fd = -1;
+		}
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		zvfs_epoll_drop(ep, item);
+		break;
+
+	default:
+		errno = EINVAL;
+		ret = -1;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	return ret;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct k_poll_event *ready[ZVFS_EPOLL_WAIT_BATCH];
+	struct zvfs_epoll_item *item, *next;
+	struct zvfs_epoll *ep;
+	sys_dlist_t handled;
+	k_timepoint_t end;
+	int count = 0;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+	sys_dlist_init(&handled);
+
+	do {
+		k_timeout_t remaining = sys_timepoint_timeout(end);
+		int max = MIN(maxevents, ZVFS_EPOLL_WAIT_BATCH);
+		int nready;
+
+		if (!sys_dlist_is_empty(&ep->always_ready)) {
+			remaining = K_NO_WAIT;
+		}
+
+		nready = k_poll_set_wait(&ep->set, ready, max, remaining);
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+		/* Fetch further batches while the poll set has more to hand out.
+		 * Both events of a descriptor may fire in the same round, and the
+		 * poll set hands out again the events of the previous batches that
+		 * are still ready, each item is only handled once per round.
+		 */
+		for (;;) {
+			bool progress = false;
+
+			for (int i = 0; i < nready; i++) {
+				item = zvfs_epoll_item_of(ep, ready[i]);
+
+				if (item->fd >= 0 && !sys_dnode_is_linked(&item->ready_node)) {
+					sys_dlist_append(&handled, &item->ready_node);
+					count += zvfs_epoll_report(ep, item, &events[count]);
+					progress = true;
+				}
+			}
+
+			if (nready < max || !progress || count == maxevents) {
+				break;
+			}
+
+			max = MIN(maxevents - count, ZVFS_EPOLL_WAIT_BATCH);
+			nready = k_poll_set_wait(&ep->set, ready, max, K_NO_WAIT);
+		}
+
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->always_ready, item, next, always_node) {
+			if (count == maxevents) {
+				break;
+			}
+
+			if (!sys_dnode_is_linked(&item->ready_node)) {
+				sys_dlist_append(&handled, &item->ready_node);
+				count += zvfs_epoll_report(ep, item, &events[count]);
+			}
+		}
+
+		/* Start from the items left out when more are always ready than
+		 * the caller can take, so that all of them get their turn.
+		 */
+		while (item != NULL &&
+		       sys_dlist_peek_head(&ep->always_ready) != &item->always_node) {
+			sys_dlist_append(&ep->always_ready, sys_dlist_get(&ep->always_ready));
+		}
+
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&handled, item, next, ready_node) {
+			sys_dlist_remove(&item->ready_node);
+		}
+
+		k_mutex_unlock(&ep->lock);
+	} while (count == 0 && !sys_timepoint_expired(end));
+
+	return count;
+}
@@ -408,6 +408,11 @@ int zvfs_close(int fd)
 		return -1;
 	}
 
+#ifdef CONFIG_ZVFS_EPOLL
+	/* Kernel objects of fd must not stay registered once it is closed */
+	zvfs_epoll_close_fd(fd);
+#endif
+
 	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
 	if (fdtable[fd].vtable->close != NULL) {
 		/* close() is optional - e.g. stdinout_fd_op_vtable */
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Boot profile comparison
+
+Compares two boot profiles dumped with CONFIG_PROFILING_BOOT_DUMP or the
+"boot_profile dump" shell command, and flags the boot phases and init entries
+that got slower. The input files can be raw console logs: only the lines
+between "boot_profile,<version>,..." and "boot_profile,end" are parsed.
+
+Usage:
+    ./scripts/profiling/boot_profile_compare.py baseline.log current.log
+
+The exit code is 1 when a regression is found, so the script can gate CI.
+"""
+
+import argparse
+import csv
+import re
+import sys
+
+SUPPORTED_VERSION = 1
+
+# Console prefixes (log timestamps, shell prompt) are dropped up to the kind
+START_RE = re.compile(r"boot_profile,(\d+),(\d+)\s*$")
+LINE_RE = re.compile(r"(phase|sys_init|device),.*$")
+
+# Phases adding up to the time from reset to main(), arch_init is part of pre_kernel
+TOTAL_PHASES = ("bss_zero", "data_copy", "pre_kernel", "post_kernel")
+
+
+def parse(path):
+    """Return {(kind, name, level): duration_us} for the last dump of a file."""
+    entries = None
+    last = None
+
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.rstrip()
+
+            match = START_RE.search(line)
+            if match:
+                if int(match.group(1)) != SUPPORTED_VERSION:
+                    sys.exit(f"{path}: unsupported boot profile version {match.group(1)}")
+                entries = {}
+                continue
+
+            if entries is None:
+                continue
+
+            if line.endswith("boot_profile,end"):
+                last = entries
+                entries = None
+                continue
+
+            match = LINE_RE.search(line)
+            if not match:
+                continue
+
+            kind, name, level, _prio, _start, duration, _result = next(
+                csv.reader([match.group(0)])
+            )
+            key = (kind, name, level)
+            # The same function may be registered several times
+            entries[key] = entries.get(key, 0) + int(duration)
+
+    if last is None:
+        sys.exit(f"{path}: no boot profile found")
+
+    return last
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        allow_abbrev=False,
+    )
+    parser.add_argument("baseline", help="boot profile of the reference build")
+    parser.add_argument("current", help="boot profile of the build to check")
+    parser.add_argument(
+        "--threshold-us",
+        type=int,
+        default=100,
+        help="minimum slowdown, in microseconds, to report (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--threshold-percent",
+        type=float,
+        default=10.0,
+        help="minimum slowdown, in percent, to report (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--all", action="store_true", help="print all entries, not only the regressions"
+    )
+    args = parser.parse_args()
+
+    baseline = parse(args.baseline)
+    current = parse(args.current)
+    regressions = 0
+
+    print(f"{'kind':<9} {'name':<32} {'level':<13} {'base us':>9} {'now us':>9} {'delta':>9}")
+    for key in sorted(set(baseline) | set(current)):
+        kind, name, level = key
+        base = baseline.get(key)
+        now = current.get(key)
+
+        if base is None or now is None:
+            flag = "new" if base is None else "removed"
+            delta = 0
+        else:
+            delta = now - base
+            slower = delta >= args.threshold_us and (
+                base == 0 or 100.0 * delta / base >= args.threshold_percent
+            )
+            flag = "REGRESSION" if slower else ""
+            regressions += slower
+
+        if flag or args.all:
+            base_str = "-" if base is None else str(base)
+            now_str = "-" if now is None else str(now)
+            print(
+                f"{kind:<9} {name:<32} {level:<13} {base_str:>9} {now_str:>9} {delta:>+9} {flag}"
+            )
+
+    total_base = sum(v for (k, n, _), v in baseline.items() if k == "phase" and n in TOTAL_PHASES)
+    total_now = sum(v for (k, n, _), v in current.items() if k == "phase" and n in TOTAL_PHASES)
+    print(f"\nboot time: {total_base} us -> {total_now} us ({total_now - total_base:+} us)")
+    print(f"{regressions} regression(s)")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,372 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Compressed RAM backing store implementation
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <zephyr/kernel.h>
+#include <zephyr/linker/sections.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/*
+ * Evicted data pages are compressed with an LZF compatible encoder and kept
+ * in a sys_heap pool, so the pool holds more data pages than it would
+ * uncompressed. Data pages that do not shrink enough are kept as is.
+ *
+ * A location token is a slot index scaled to the page size, as the
+ * architecture code requires page aligned locations. Storage for a whole
+ * data page is reserved by k_mem_paging_backing_store_location_get(), since
+ * k_mem_paging_backing_store_page_out() cannot fail, and is shrunk in place
+ * to the compressed size once the data page is written.
+ *
+ * Like the RAM backing store, locations are freed as soon as data pages are
+ * paged in, so K_MEM_PAGE_FRAME_BACKED is never set.
+ */
+
+#define NUM_SLOTS	CONFIG_BACKING_STORE_RAM_PAGES
+
+/* Compressed data pages must save at least this much to be kept compressed */
+#define MAX_COMPRESSED_SIZE	(CONFIG_MMU_PAGE_SIZE - (CONFIG_MMU_PAGE_SIZE / 8))
+
+/*
+ * LZF format: a control byte below 32 is followed by (control + 1) literal
+ * bytes. Otherwise the top 3 bits of the control byte give the match length
+ * minus 2, 7 meaning an extra byte follows to add to it, and the low 5 bits
+ * then the next byte give the match distance minus 1.
+ */
+#define LZF_HASH_BITS	10
+#define LZF_MAX_LIT	32U
+#define LZF_MAX_OFF	8192U
+#define LZF_MAX_REF	264U
+
+BUILD_ASSERT(CONFIG_MMU_PAGE_SIZE <= UINT16_MAX, "hash table holds 16-bit offsets");
+BUILD_ASSERT(NUM_SLOTS <= UINT16_MAX, "free slots are 16-bit indexes");
+
+struct compressed_slot {
+	void *data;
+	uint16_t len;
+};
+
+/*
+ * Everything below is accessed while handling page faults, so it must never
+ * be paged out itself.
+ */
+static __pinned_bss uint8_t pool_mem[CONFIG_BACKING_STORE_COMPRESSED_RAM_POOL_SIZE]
+	__aligned(sizeof(void *));
+static __pinned_bss struct sys_heap pool;
+
+static __pinned_bss struct compressed_slot slots[NUM_SLOTS];
+static __pinned_bss uint16_t free_slots[NUM_SLOTS];
+static __pinned_bss unsigned int num_free_slots;
+
+/* Storage kept aside so that page faults always get a location */
+static __pinned_bss void *reserve;
+
+/* Page-ins and page-outs are serialized, they can share the hash table */
+static __pinned_bss uint16_t lzf_hash[1U << LZF_HASH_BITS];
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+static __pinned_bss struct k_spinlock stats_lock;
+static __pinned_bss struct k_mem_paging_backing_store_stats_t stats;
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
+static inline uint32_t lzf_hash_idx(const uint8_t *p)
+{
+	uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+
+	return (v * 2654435761U) >> (32 - LZF_HASH_BITS);
+}
+
+/* Return the compressed size, or 0 if it would exceed out_len */
+static size_t lzf_compress(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_len)
+{
+	const uint8_t *ip = in;
+	const uint8_t *in_end = in + in_len;
+	uint8_t *op = out;
+	uint8_t *out_end = out + out_len;
+	uint8_t *lit_ctrl;
+	unsigned int lit = 0U;
+
+	(void)memset(lzf_hash, 0, sizeof(lzf_hash));
+
+	if (out_len < 2U) {
+		return 0;
+	}
+	lit_ctrl = op++;
+
+	while (ip < in_end) {
+		if ((in_end - ip) > 2) {
+			uint32_t h = lzf_hash_idx(ip);
+			/* Hash entries hold the offset of the last position plus one */
+			const uint8_t *ref = (lzf_hash[h] != 0U) ? (in + lzf_hash[h] - 1) : NULL;
+
+			lzf_hash[h] = (uint16_t)(ip - in + 1);
+
+			if ((ref != NULL) && ((size_t)(ip - ref - 1) < LZF_MAX_OFF) &&
+			    (ref[0] == ip[0]) && (ref[1] == ip[1]) && (ref[2] == ip[2])) {
+				size_t off = ip - ref - 1;
+				size_t max = MIN((size_t)(in_end - ip), LZF_MAX_REF);
+				size_t len = 3U;
+
+				while ((len < max) && (ref[len] == ip[len])) {
+					len++;
+				}
+
+				/* Close the literal run, or drop its unused control byte */
+				if (lit > 0U) {
+					*lit_ctrl = lit - 1U;
+				} else {
+					op--;
+				}
+
+				if ((op + 4) > out_end) {
+					return 0;
+				}
+
+				if ((len - 2U) < 7U) {
+					*op++ = ((len - 2U) << 5) | (off >> 8);
+				} else {
+					*op++ = (7U << 5) | (off >> 8);
+					*op++ = len - 2U - 7U;
+				}
+				*op++ = off & 0xffU;
+
+				ip += len;
+				lit_ctrl = op++;
+				lit = 0U;
+				continue;
+			}
+		}
+
+		if ((op + 2) > out_end) {
+			return 0;
+		}
+
+		*op++ = *ip++;
+		lit++;
+		if (lit == LZF_MAX_LIT) {
+			*lit_ctrl = lit - 1U;
+			lit_ctrl = op++;
+			lit = 0U;
+		}
+	}
+
+	if (lit > 0U) {
+		*lit_ctrl = lit - 1U;
+	} else {
+		op--;
+	}
+
+	return op - out;
+}
+
+/* Return the decompressed size, or -EINVAL on corrupted input */
+static int lzf_decompress(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_len)
+{
+	const uint8_t *ip = in;
+	const uint8_t *in_end = in + in_len;
+	uint8_t *op = out;
+	uint8_t *out_end = out + out_len;
+
+	while (ip < in_end) {
+		unsigned int ctrl = *ip++;
+
+		if (ctrl < LZF_MAX_LIT) {
+			ctrl++;
+			if (((op + ctrl) > out_end) || ((ip + ctrl) > in_end)) {
+				return -EINVAL;
+			}
+
+			(void)memcpy(op, ip, ctrl);
+			op += ctrl;
+			ip += ctrl;
+		} else {
+			unsigned int len = ctrl >> 5;
+			const uint8_t *ref = op - ((ctrl & 0x1fU) << 8) - 1;
+
+			if (len == 7U) {
+				if (ip >= in_end) {
+					return -EINVAL;
+				}
+				len += *ip++;
+			}
+
+			if (ip >= in_end) {
+				return -EINVAL;
+			}
+			ref -= *ip++;
+			len += 2U;
+
+			if (((op + len) > out_end) || (ref < out)) {
+				return -EINVAL;
+			}
+
+			/* Matches may overlap the bytes being written */
+			while (len-- > 0U) {
+				*op++ = *ref++;
+			}
+		}
+	}
+
+	return op - out;
+}
+
+static struct compressed_slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location / CONFIG_MMU_PAGE_SIZE < NUM_SLOTS,
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return &slots[location / CONFIG_MMU_PAGE_SIZE];
+}
+
+int k_mem_paging_backing_store_location_get(struct k_mem_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	void *data;
+	unsigned int idx;
+
+	ARG_UNUSED(pf);
+
+	if ((!page_fault && num_free_slots == 1U) || num_free_slots == 0U) {
+		return -ENOMEM;
+	}
+
+	data = sys_heap_alloc(&pool, CONFIG_MMU_PAGE_SIZE);
+	if ((data == NULL) && page_fault) {
+		data = reserve;
+		reserve = NULL;
+	}
+
+	if (data == NULL) {
+		return -ENOMEM;
+	}
+
+	idx = free_slots[--num_free_slots];
+	slots[idx].data = data;
+	slots[idx].len = 0U;
+	*location = idx * CONFIG_MMU_PAGE_SIZE;
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	struct compressed_slot *slot = location_to_slot(location);
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	if (slot->len != 0U) {
+		k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+		stats.pages--;
+		stats.orig_bytes -= CONFIG_MMU_PAGE_SIZE;
+		stats.stored_bytes -= slot->len;
+		if (slot->len == CONFIG_MMU_PAGE_SIZE) {
+			stats.incompressible--;
+		}
+
+		k_spin_unlock(&stats_lock, key);
+	}
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
+	sys_heap_free(&pool, slot->data);
+	slot->data = NULL;
+	slot->len = 0U;
+	free_slots[num_free_slots++] = slot - slots;
+
+	if (reserve == NULL) {
+		reserve = sys_heap_alloc(&pool, CONFIG_MMU_PAGE_SIZE);
+	}
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	struct compressed_slot *slot = location_to_slot(location);
+	size_t len;
+
+	len = lzf_compress(K_MEM_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE, slot->data,
+			   MAX_COMPRESSED_SIZE);
+	if (len == 0U) {
+		(void)memcpy(slot->data, K_MEM_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE);
+		len = CONFIG_MMU_PAGE_SIZE;
+	} else {
+		/* Shrinking always happens in place */
+		slot->data = sys_heap_realloc(&pool, slot->data, len);
+		__ASSERT(slot->data != NULL, "failed to shrink compressed page");
+	}
+	slot->len = len;
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	stats.pages++;
+	stats.orig_bytes += CONFIG_MMU_PAGE_SIZE;
+	stats.stored_bytes += len;
+	if (len == CONFIG_MMU_PAGE_SIZE) {
+		stats.incompressible++;
+	}
+
+	k_spin_unlock(&stats_lock, key);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	struct compressed_slot *slot = location_to_slot(location);
+	int ret;
+
+	if (slot->len == CONFIG_MMU_PAGE_SIZE) {
+		(void)memcpy(K_MEM_SCRATCH_PAGE, slot->data, CONFIG_MMU_PAGE_SIZE);
+		return;
+	}
+
+	ret = lzf_decompress(slot->data, slot->len, K_MEM_SCRATCH_PAGE,
+			     CONFIG_MMU_PAGE_SIZE);
+	__ASSERT(ret == CONFIG_MMU_PAGE_SIZE, "corrupted compressed page at 0x%lx",
+		 location);
+	(void)ret;
+}
+
+void k_mem_paging_backing_store_page_finalize(struct k_mem_page_frame *pf,
+					      uintptr_t location)
+{
+#ifdef CONFIG_DEMAND_MAPPING
+	/* ignore those */
+	if (location == ARCH_UNPAGED_ANON_ZERO || location == ARCH_UNPAGED_ANON_UNINIT) {
+		return;
+	}
+#endif
+	k_mem_paging_backing_store_location_free(location);
+}
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+void k_mem_paging_backing_store_stats(struct k_mem_paging_backing_store_stats_t *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	*out = stats;
+
+	k_spin_unlock(&stats_lock, key);
+}
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
+void k_mem_paging_backing_store_init(void)
+{
+	sys_heap_init(&pool, pool_mem, sizeof(pool_mem));
+
+	for (unsigned int i = 0; i < NUM_SLOTS; i++) {
+		free_slots[i] = NUM_SLOTS - 1U - i;
+	}
+	num_free_slots = NUM_SLOTS;
+
+	reserve = sys_heap_alloc(&pool, CONFIG_MMU_PAGE_SIZE);
+	__ASSERT(reserve != NULL, "compressed backing store pool too small");
+}
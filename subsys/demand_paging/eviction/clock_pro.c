@@ -0,0 +1,277 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CLOCK-Pro eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/*
+ * Page frames hold either hot or cold data pages. A cold data page is in its
+ * test period from the time it is loaded or found accessed until the clock
+ * hand finds it not accessed again. A cold data page accessed during its test
+ * period is promoted to hot, while a hot data page not accessed since the last
+ * pass of the clock hand is demoted to cold when there are more hot data pages
+ * than allowed. Only cold, not accessed data pages are evicted.
+ *
+ * Without eviction tracking from the architecture, the accessed state is
+ * sampled from the page tables by a periodic timer and by the clock hand, and
+ * a page frame holding another data page than last time is detected by
+ * comparing virtual addresses.
+ *
+ * Cold data pages evicted during their test period are remembered in a small
+ * history. One faulting back in while still remembered starts hot, and means
+ * cold data pages need more page frames. A remembered data page dropped from
+ * the history without faulting back in means they need fewer.
+ */
+
+#define PF_HOT		BIT(0)
+#define PF_TEST		BIT(1)
+#define PF_REF		BIT(2)
+
+/* Data page virtual addresses are page aligned, mark used history entries */
+#define HISTORY_VALID	BIT(0)
+
+#define NUM_FRAMES	ARRAY_SIZE(k_mem_page_frames)
+
+static struct k_spinlock clock_pro_lock;
+
+static uint8_t pf_state[NUM_FRAMES];
+static void *pf_virt[NUM_FRAMES];
+
+static uintptr_t history[CONFIG_EVICTION_CLOCK_PRO_HISTORY];
+static size_t history_next;
+
+static size_t hand;
+static size_t cold_target;
+static size_t hot_count;
+static size_t num_evictable;
+
+static bool history_remove(void *virt)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(history); i++) {
+		if (history[i] == ((uintptr_t)virt | HISTORY_VALID)) {
+			history[i] = 0U;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void history_add(void *virt)
+{
+	if (((history[history_next] & HISTORY_VALID) != 0U) && (cold_target > 1U)) {
+		/* Test period over without a refault */
+		cold_target--;
+	}
+
+	history[history_next] = (uintptr_t)virt | HISTORY_VALID;
+	history_next = (history_next + 1U) % ARRAY_SIZE(history);
+}
+
+/* Reset the state of page frames now holding another data page */
+static void frame_sync(size_t idx, struct k_mem_page_frame *pf)
+{
+	void *virt = k_mem_page_frame_to_virt(pf);
+
+	if (pf_virt[idx] == virt) {
+		return;
+	}
+
+	pf_virt[idx] = virt;
+	if (history_remove(virt)) {
+		pf_state[idx] = PF_HOT;
+		if (cold_target < (NUM_FRAMES - 1U)) {
+			cold_target++;
+		}
+	} else {
+		pf_state[idx] = PF_TEST;
+	}
+}
+
+static void frames_update(bool sample)
+{
+	uintptr_t phys;
+	struct k_mem_page_frame *pf;
+
+	hot_count = 0U;
+	num_evictable = 0U;
+
+	K_MEM_PAGE_FRAME_FOREACH(phys, pf) {
+		size_t idx = pf - k_mem_page_frames;
+
+		if (!k_mem_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		frame_sync(idx, pf);
+
+		if (sample) {
+			uintptr_t flags = arch_page_info_get(k_mem_page_frame_to_virt(pf),
+							     NULL, true);
+
+			if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0U) {
+				pf_state[idx] |= PF_REF;
+			}
+		}
+
+		num_evictable++;
+		if ((pf_state[idx] & PF_HOT) != 0U) {
+			hot_count++;
+		}
+	}
+}
+
+static void clock_pro_periodic_update(struct k_timer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&clock_pro_lock);
+
+	ARG_UNUSED(timer);
+
+	frames_update(true);
+
+	k_spin_unlock(&clock_pro_lock, key);
+}
+
+/* Advance the clock hand over one page frame, return true if it can be evicted */
+static bool clock_pro_hand(size_t idx, struct k_mem_page_frame *pf, size_t hot_max)
+{
+	uintptr_t flags = arch_page_info_get(k_mem_page_frame_to_virt(pf), NULL, true);
+	uint8_t state = pf_state[idx];
+
+	if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0U) {
+		state |= PF_REF;
+	}
+
+	if ((state & PF_HOT) != 0U) {
+		if ((state & PF_REF) != 0U) {
+			state &= ~PF_REF;
+		} else if (hot_count > hot_max) {
+			/* Demoted pages are not in a test period */
+			state = 0U;
+			hot_count--;
+		}
+	} else if ((state & PF_REF) != 0U) {
+		if ((state & PF_TEST) != 0U) {
+			state = PF_HOT;
+			hot_count++;
+		} else {
+			state = PF_TEST;
+		}
+	} else {
+		return true;
+	}
+
+	pf_state[idx] = state;
+
+	return false;
+}
+
+struct k_mem_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct k_mem_page_frame *pf = NULL;
+	size_t hot_max;
+	size_t idx;
+	uintptr_t flags;
+	k_spinlock_key_t key = k_spin_lock(&clock_pro_lock);
+
+	frames_update(false);
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(num_evictable > 0U, "no page to evict");
+
+	hot_max = num_evictable - CLAMP(cold_target, 1U, MAX(num_evictable, 2U) - 1U);
+
+	/*
+	 * The first lap clears the accessed state of hot pages, the second
+	 * demotes them, the third one finds them cold.
+	 */
+	for (size_t n = 0U; n < (3U * NUM_FRAMES); n++) {
+		idx = hand;
+		hand = (hand + 1U) % NUM_FRAMES;
+
+		if (!k_mem_page_frame_is_evictable(&k_mem_page_frames[idx])) {
+			continue;
+		}
+
+		if (clock_pro_hand(idx, &k_mem_page_frames[idx], hot_max)) {
+			pf = &k_mem_page_frames[idx];
+			break;
+		}
+	}
+
+	/* Pages kept being accessed behind the hand, take the next one */
+	while (pf == NULL) {
+		idx = hand;
+		hand = (hand + 1U) % NUM_FRAMES;
+
+		if (k_mem_page_frame_is_evictable(&k_mem_page_frames[idx])) {
+			pf = &k_mem_page_frames[idx];
+		}
+	}
+
+	flags = arch_page_info_get(k_mem_page_frame_to_virt(pf), NULL, false);
+
+	/* Implies a mismatch with page frame ontology and page
+	 * tables
+	 */
+	__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+		 "non-present page, %s",
+		 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+		 "un-mapped" : "paged out");
+
+	if ((pf_state[idx] & PF_TEST) != 0U) {
+		history_add(pf_virt[idx]);
+	}
+
+	/* Whatever gets loaded in this page frame next is a new page */
+	pf_state[idx] = 0U;
+	pf_virt[idx] = NULL;
+
+	k_spin_unlock(&clock_pro_lock, key);
+
+	*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0U;
+
+	return pf;
+}
+
+static K_TIMER_DEFINE(clock_pro_timer, clock_pro_periodic_update, NULL);
+
+void k_mem_paging_eviction_init(void)
+{
+	cold_target = NUM_FRAMES / 2U;
+
+	k_timer_start(&clock_pro_timer, K_NO_WAIT,
+		      K_MSEC(CONFIG_EVICTION_CLOCK_PRO_PERIOD));
+}
+
+#ifdef CONFIG_EVICTION_TRACKING
+/*
+ * Empty functions defined here so that architectures unconditionally
+ * implement eviction tracking can still use this algorithm for
+ * testing.
+ */
+
+void k_mem_paging_eviction_add(struct k_mem_page_frame *pf)
+{
+	ARG_UNUSED(pf);
+}
+
+void k_mem_paging_eviction_remove(struct k_mem_page_frame *pf)
+{
+	ARG_UNUSED(pf);
+}
+
+void k_mem_paging_eviction_accessed(uintptr_t phys)
+{
+	ARG_UNUSED(phys);
+}
+
+#endif /* CONFIG_EVICTION_TRACKING */
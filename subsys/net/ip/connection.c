@@ -17,6 +17,8 @@
 LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/util.h>
 
 #include <zephyr/net/net_core.h>
@@ -56,11 +58,34 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Remote and local addresses and ports all specified, highest rank */
+#define NET_CONN_ALL_SPEC		(NET_CONN_REMOTE_PORT_SPEC | \
+					 NET_CONN_LOCAL_PORT_SPEC | \
+					 NET_CONN_REMOTE_ADDR_SPEC | \
+					 NET_CONN_LOCAL_ADDR_SPEC)
+
+/* Lookup lists of an incoming packet: 4-tuple bucket, port bucket, wildcard */
+#define NET_CONN_INPUT_LISTS		3
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* Used connections are also in one of the lookup lists below, through their
+ * hash_node: those with all addresses and ports specified are hashed on
+ * their 4-tuple, the other ones with a local port on their protocol and
+ * local port, and the remaining ones are wildcards checked for every packet.
+ */
+static sys_slist_t conn_tuple_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_port_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+
+/* Odd while the lookup lists are modified, incremented twice for each
+ * modification, so that unicast packets are looked up without conn_lock.
+ */
+static atomic_t conn_seq;
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -113,6 +138,112 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
+{
+	hash = (hash ^ val) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+static uint32_t conn_hash_addr(uint32_t hash, const uint8_t *addr, size_t len)
+{
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = conn_hash_mix(hash, UNALIGNED_GET((const uint32_t *)&addr[i]));
+	}
+
+	return hash;
+}
+
+/* Ports in network byte order, as stored in connections and packets */
+static sys_slist_t *conn_tuple_bucket(uint16_t proto, uint8_t family,
+				      const uint8_t *local_addr,
+				      const uint8_t *remote_addr,
+				      uint16_t local_port, uint16_t remote_port)
+{
+	size_t len = family == NET_AF_INET6 ? NET_IPV6_ADDR_SIZE : NET_IPV4_ADDR_SIZE;
+	uint32_t hash;
+
+	hash = conn_hash_mix(((uint32_t)proto << 8) | family,
+			     ((uint32_t)local_port << 16) | remote_port);
+	hash = conn_hash_addr(hash, local_addr, len);
+	hash = conn_hash_addr(hash, remote_addr, len);
+
+	return &conn_tuple_hash[hash % CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static sys_slist_t *conn_port_bucket(uint16_t proto, uint16_t local_port)
+{
+	uint32_t hash = conn_hash_mix(proto, local_port);
+
+	return &conn_port_hash[hash % CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static const uint8_t *conn_addr_raw(const struct net_sockaddr *addr)
+{
+	if (addr->sa_family == NET_AF_INET6) {
+		return net_sin6(addr)->sin6_addr.s6_addr;
+	}
+
+	return net_sin(addr)->sin_addr.s4_addr;
+}
+
+static bool conn_is_tuple_family(uint8_t family)
+{
+	return (IS_ENABLED(CONFIG_NET_IPV4) && family == NET_AF_INET) ||
+	       (IS_ENABLED(CONFIG_NET_IPV6) && family == NET_AF_INET6);
+}
+
+/* Lookup list of a connection, which must not change while it is in use */
+static sys_slist_t *conn_list(const struct net_conn *conn)
+{
+	const struct net_sockaddr *local = &conn->local_addr;
+	const struct net_sockaddr *remote = &conn->remote_addr;
+
+	if (!conn_is_tuple_family(conn->family) && conn->family != NET_AF_UNSPEC) {
+		return &conn_wildcard;
+	}
+
+	if ((conn->flags & NET_CONN_ALL_SPEC) == NET_CONN_ALL_SPEC &&
+	    conn_is_tuple_family(conn->family) &&
+	    local->sa_family == conn->family && remote->sa_family == conn->family) {
+		return conn_tuple_bucket(conn->proto, conn->family,
+					 conn_addr_raw(local), conn_addr_raw(remote),
+					 net_sin(local)->sin_port,
+					 net_sin(remote)->sin_port);
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0U) {
+		return conn_port_bucket(conn->proto, net_sin(local)->sin_port);
+	}
+
+	return &conn_wildcard;
+}
+
+/* Lookup list modifications are done with conn_lock held */
+static inline void conn_seq_write_begin(void)
+{
+	(void)atomic_inc(&conn_seq);
+}
+
+static inline void conn_seq_write_end(void)
+{
+	(void)atomic_inc(&conn_seq);
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	conn_seq_write_begin();
+	sys_slist_prepend(conn_list(conn), &conn->hash_node);
+	conn_seq_write_end();
+}
+
+static void conn_hash_remove(struct net_conn *conn)
+{
+	conn_seq_write_begin();
+	(void)sys_slist_find_and_remove(conn_list(conn), &conn->hash_node);
+	conn_seq_write_end();
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -138,6 +269,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -150,115 +282,151 @@ static void conn_set_unused(struct net_conn *conn)
 	k_mutex_unlock(&conn_lock);
 }
 
-/* Check if we already have identical connection handler installed. */
-static struct net_conn *conn_find_handler(struct net_if *iface,
-					  uint16_t proto, uint8_t family,
-					  const struct net_sockaddr *remote_addr,
-					  const struct net_sockaddr *local_addr,
-					  uint16_t remote_port,
-					  uint16_t local_port,
-					  bool reuseport_set)
+static bool conn_is_identical(struct net_conn *conn, struct net_if *iface,
+			      uint16_t proto, uint8_t family,
+			      const struct net_sockaddr *remote_addr,
+			      const struct net_sockaddr *local_addr,
+			      uint16_t remote_port,
+			      uint16_t local_port,
+			      bool reuseport_set)
 {
-	struct net_conn *conn;
-	struct net_conn *tmp;
-
-	k_mutex_lock(&conn_lock, K_FOREVER);
+	if (conn->proto != proto) {
+		return false;
+	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
-		if (conn->proto != proto) {
-			continue;
-		}
+	if (conn->family != family) {
+		return false;
+	}
 
-		if (conn->family != family) {
-			continue;
+	if (local_addr) {
+		if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
+			return false;
 		}
 
-		if (local_addr) {
-			if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
-				continue;
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    local_addr->sa_family == NET_AF_INET6 &&
+		    local_addr->sa_family ==
+		    conn->local_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(local_addr)->sin6_addr,
+				    &net_sin6(&conn->local_addr)->
+							sin6_addr)) {
+				return false;
 			}
-
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    local_addr->sa_family == NET_AF_INET6 &&
-			    local_addr->sa_family ==
-			    conn->local_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(local_addr)->sin6_addr,
-					    &net_sin6(&conn->local_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   local_addr->sa_family == NET_AF_INET &&
-				   local_addr->sa_family ==
-				   conn->local_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(local_addr)->sin_addr,
-					    &net_sin(&conn->local_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   local_addr->sa_family == NET_AF_INET &&
+			   local_addr->sa_family ==
+			   conn->local_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(local_addr)->sin_addr,
+				    &net_sin(&conn->local_addr)->
+							sin_addr)) {
+				return false;
 			}
-		} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-			continue;
+		} else {
+			return false;
 		}
+	} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		return false;
+	}
 
-		if (net_sin(&conn->local_addr)->sin_port !=
-		    net_htons(local_port)) {
-			continue;
+	if (net_sin(&conn->local_addr)->sin_port !=
+	    net_htons(local_port)) {
+		return false;
+	}
+
+	if (remote_addr) {
+		if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+			return false;
 		}
 
-		if (remote_addr) {
-			if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
-				continue;
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    remote_addr->sa_family == NET_AF_INET6 &&
+		    remote_addr->sa_family ==
+		    conn->remote_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(remote_addr)->sin6_addr,
+				    &net_sin6(&conn->remote_addr)->
+							sin6_addr)) {
+				return false;
 			}
-
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    remote_addr->sa_family == NET_AF_INET6 &&
-			    remote_addr->sa_family ==
-			    conn->remote_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(remote_addr)->sin6_addr,
-					    &net_sin6(&conn->remote_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   remote_addr->sa_family == NET_AF_INET &&
-				   remote_addr->sa_family ==
-				   conn->remote_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(remote_addr)->sin_addr,
-					    &net_sin(&conn->remote_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   remote_addr->sa_family == NET_AF_INET &&
+			   remote_addr->sa_family ==
+			   conn->remote_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(remote_addr)->sin_addr,
+				    &net_sin(&conn->remote_addr)->
+							sin_addr)) {
+				return false;
 			}
-		} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-			continue;
-		} else if (reuseport_set && conn->context != NULL &&
-			   net_context_is_reuseport_set(conn->context)) {
-			continue;
+		} else {
+			return false;
 		}
+	} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		return false;
+	} else if (reuseport_set && conn->context != NULL &&
+		   net_context_is_reuseport_set(conn->context)) {
+		return false;
+	}
 
-		if (net_sin(&conn->remote_addr)->sin_port !=
-		    net_htons(remote_port)) {
-			continue;
+	if (net_sin(&conn->remote_addr)->sin_port !=
+	    net_htons(remote_port)) {
+		return false;
+	}
+
+	if (conn->context != NULL && iface != NULL &&
+	    net_context_is_bound_to_iface(conn->context)) {
+		if (iface != net_context_get_iface(conn->context)) {
+			return false;
 		}
+	}
 
-		if (conn->context != NULL && iface != NULL &&
-		    net_context_is_bound_to_iface(conn->context)) {
-			if (iface != net_context_get_iface(conn->context)) {
-				continue;
-			}
+	return true;
+}
+
+/* Check if we already have identical connection handler installed. */
+static struct net_conn *conn_find_handler(struct net_if *iface,
+					  uint16_t proto, uint8_t family,
+					  const struct net_sockaddr *remote_addr,
+					  const struct net_sockaddr *local_addr,
+					  uint16_t remote_port,
+					  uint16_t local_port,
+					  bool reuseport_set)
+{
+	sys_slist_t *lists[NET_CONN_INPUT_LISTS];
+	size_t num_lists = 0;
+	struct net_conn *conn;
+
+	/* An identical connection is in the list this one would go to */
+	if (local_port != 0U) {
+		if (remote_addr != NULL && local_addr != NULL && remote_port != 0U &&
+		    conn_is_tuple_family(local_addr->sa_family) &&
+		    remote_addr->sa_family == local_addr->sa_family) {
+			lists[num_lists++] = conn_tuple_bucket(proto, local_addr->sa_family,
+							       conn_addr_raw(local_addr),
+							       conn_addr_raw(remote_addr),
+							       net_htons(local_port),
+							       net_htons(remote_port));
 		}
 
-		k_mutex_unlock(&conn_lock);
-		return conn;
+		lists[num_lists++] = conn_port_bucket(proto, net_htons(local_port));
+	}
+
+	lists[num_lists++] = &conn_wildcard;
+
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
+	for (size_t i = 0; i < num_lists; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
+			if (conn_is_identical(conn, iface, proto, family,
+					      remote_addr, local_addr,
+					      remote_port, local_port,
+					      reuseport_set)) {
+				k_mutex_unlock(&conn_lock);
+				return conn;
+			}
+		}
 	}
 
 	k_mutex_unlock(&conn_lock);
@@ -435,10 +603,10 @@ int net_conn_register(uint16_t proto, enum net_sock_type type, uint8_t family,
 		*handle = (struct net_conn_handle *)conn;
 	}
 
-	conn_set_used(conn);
-
 	conn->v6only = net_context_is_v6only_set(context);
 
+	conn_set_used(conn);
+
 	conn_register_debug(conn, remote_port, local_port);
 
 	return 0;
@@ -463,6 +631,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -489,14 +658,21 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	/* The connection may move to another lookup list */
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_seq_write_begin();
+	(void)sys_slist_find_and_remove(conn_list(conn), &conn->hash_node);
+
 	net_conn_change_callback(conn, cb, user_data);
 
 	ret = net_conn_change_local(conn, local_addr, local_port);
-	if (ret < 0) {
-		return ret;
+	if (ret == 0) {
+		ret = net_conn_change_remote(conn, remote_addr, remote_port);
 	}
 
-	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	sys_slist_prepend(conn_list(conn), &conn->hash_node);
+	conn_seq_write_end();
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -844,6 +1020,188 @@ enum net_verdict net_conn_can_input(struct net_pkt *pkt, uint8_t proto)
 }
 #endif /* defined(CONFIG_NET_SOCKETS_CAN) */
 
+/* Rank of a connection matching an incoming TCP/UDP packet, -1 if it does not */
+static int conn_input_rank(struct net_conn *conn, struct net_pkt *pkt,
+			   union net_ip_header *ip_hdr, uint8_t proto,
+			   uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	/* Is the candidate connection matching the packet's interface? */
+	if (!is_iface_matching(conn, pkt)) {
+		return -1; /* wrong interface */
+	}
+
+	/* Is the candidate connection matching the packet's protocol family? */
+	if (conn->family != NET_AF_UNSPEC && conn->family != pkt_family) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == NET_AF_INET6 && pkt_family == NET_AF_INET &&
+			      !conn->v6only && conn->type != NET_SOCK_RAW)) {
+				return -1;
+			}
+		} else {
+			return -1; /* wrong protocol family */
+		}
+
+		/* We might have a match for v4-to-v6 mapping, check more */
+	}
+
+	/* Is the candidate connection matching the packet's protocol within the family? */
+	if (conn->proto != proto) {
+		return -1; /* wrong protocol */
+	}
+
+	/* Apply protocol-specific matching criteria... */
+	uint8_t conn_family = conn->family;
+
+	if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
+	    (conn_family == NET_AF_INET || conn_family == NET_AF_INET6 ||
+	     conn_family == NET_AF_UNSPEC)) {
+		/* Is the candidate connection matching the packet's TCP/UDP
+		 * address and port?
+		 */
+		if ((conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0 &&
+		    net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return -1; /* wrong remote port */
+		}
+
+		if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0 &&
+		    net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return -1; /* wrong local port */
+		}
+
+		if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) != 0 &&
+		    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return -1; /* wrong remote address */
+		}
+
+		if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) != 0 &&
+		    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+			/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+			 * has no IPV6_V6ONLY option set and if the local IPV6 address
+			 * is unspecified, then we could accept a connection from IPv4
+			 * address by mapping it to IPv6 address.
+			 */
+			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+				if (!(conn->family == NET_AF_INET6 &&
+				      pkt_family == NET_AF_INET &&
+				      !conn->v6only &&
+				      net_ipv6_is_addr_unspecified(
+					      &net_sin6(&conn->local_addr)->sin6_addr))) {
+					return -1; /* wrong local address */
+				}
+			} else {
+				return -1; /* wrong local address */
+			}
+
+			/* We might have a match for v4-to-v6 mapping,
+			 * continue with rank checking.
+			 */
+		}
+	}
+
+	return NET_CONN_RANK(conn->flags);
+}
+
+static void conn_input_lists(sys_slist_t *lists[NET_CONN_INPUT_LISTS],
+			     struct net_pkt *pkt, union net_ip_header *ip_hdr,
+			     uint8_t proto, uint16_t src_port, uint16_t dst_port)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == NET_AF_INET6) {
+		lists[0] = conn_tuple_bucket(proto, NET_AF_INET6,
+					     ip_hdr->ipv6->dst, ip_hdr->ipv6->src,
+					     dst_port, src_port);
+	} else {
+		lists[0] = conn_tuple_bucket(proto, NET_AF_INET,
+					     ip_hdr->ipv4->dst, ip_hdr->ipv4->src,
+					     dst_port, src_port);
+	}
+
+	lists[1] = conn_port_bucket(proto, dst_port);
+	lists[2] = &conn_wildcard;
+}
+
+/* Best ranked connection for a unicast packet. Returns NULL after visiting
+ * more connections than exist, which lockless lookups can only do while the
+ * lists are modified.
+ */
+static struct net_conn *conn_input_best(sys_slist_t *lists[NET_CONN_INPUT_LISTS],
+					struct net_pkt *pkt,
+					union net_ip_header *ip_hdr, uint8_t proto,
+					uint16_t src_port, uint16_t dst_port,
+					net_conn_cb_t *cb, void **user_data)
+{
+	struct net_conn *best_match = NULL;
+	int best_rank = -1;
+	size_t visited = 0;
+	struct net_conn *conn;
+	int rank;
+
+	for (size_t i = 0; i < NET_CONN_INPUT_LISTS; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
+			if (++visited > CONFIG_NET_MAX_CONN) {
+				return NULL;
+			}
+
+			rank = conn_input_rank(conn, pkt, ip_hdr, proto, src_port, dst_port);
+			if (rank > best_rank) {
+				best_rank = rank;
+				best_match = conn;
+
+				/* Nothing ranks higher than a 4-tuple match */
+				if (rank == NET_CONN_ALL_SPEC) {
+					goto out;
+				}
+			}
+		}
+	}
+
+out:
+	if (best_match != NULL) {
+		*cb = best_match->cb;
+		*user_data = best_match->user_data;
+	}
+
+	return best_match;
+}
+
+/* Look up a unicast packet without conn_lock, or with it if the lookup
+ * lists are being modified.
+ */
+static struct net_conn *conn_input_lookup(sys_slist_t *lists[NET_CONN_INPUT_LISTS],
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr, uint8_t proto,
+					  uint16_t src_port, uint16_t dst_port,
+					  net_conn_cb_t *cb, void **user_data)
+{
+	struct net_conn *best_match;
+	atomic_val_t seq;
+
+	seq = atomic_get(&conn_seq);
+	if ((seq & 1) == 0) {
+		best_match = conn_input_best(lists, pkt, ip_hdr, proto, src_port,
+					     dst_port, cb, user_data);
+
+		/* Complete the reads above before checking for writers */
+		barrier_dmem_fence_full();
+
+		if (atomic_get(&conn_seq) == seq) {
+			return best_match;
+		}
+	}
+
+	*cb = NULL;
+	*user_data = NULL;
+
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	best_match = conn_input_best(lists, pkt, ip_hdr, proto, src_port,
+				     dst_port, cb, user_data);
+	k_mutex_unlock(&conn_lock);
+
+	return best_match;
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -884,8 +1242,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		" family %d", net_proto2str(net_pkt_family(pkt), proto), pkt,
 		net_ntohs(src_port), net_ntohs(dst_port), net_pkt_family(pkt));
 
+	sys_slist_t *lists[NET_CONN_INPUT_LISTS];
 	struct net_conn *best_match = NULL;
-	int16_t best_rank = -1;
 	bool is_mcast_pkt = false;
 	bool mcast_pkt_delivered = false;
 	bool is_bcast_pkt = false;
@@ -907,90 +1265,18 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		is_mcast_pkt = net_ipv6_is_addr_mcast_raw(ip_hdr->ipv6->dst);
 	}
 
-	k_mutex_lock(&conn_lock, K_FOREVER);
-
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (!is_iface_matching(conn, pkt)) {
-			continue; /* wrong interface */
-		}
-
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != NET_AF_UNSPEC && conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == NET_AF_INET6 && pkt_family == NET_AF_INET &&
-				      !conn->v6only && conn->type != NET_SOCK_RAW)) {
-					continue;
-				}
-			} else {
-				continue; /* wrong protocol family */
-			}
-
-			/* We might have a match for v4-to-v6 mapping, check more */
-		}
-
-		/* Is the candidate connection matching the packet's protocol within the family? */
-		if (conn->proto != proto) {
-			continue; /* wrong protocol */
-		}
-
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
-
-		if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-		    (conn_family == NET_AF_INET || conn_family == NET_AF_INET6 ||
-		     conn_family == NET_AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if ((conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0 &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0 &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
+	conn_input_lists(lists, pkt, ip_hdr, proto, src_port, dst_port);
 
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) != 0 &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) != 0 &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == NET_AF_INET6 &&
-					      pkt_family == NET_AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
-			}
+	if (is_mcast_pkt) {
+		k_mutex_lock(&conn_lock, K_FOREVER);
 
-			if (best_rank < NET_CONN_RANK(conn->flags)) {
+		for (size_t i = 0; i < NET_CONN_INPUT_LISTS; i++) {
+			SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
 				struct net_pkt *mcast_pkt;
 
-				if (!is_mcast_pkt) {
-					best_rank = NET_CONN_RANK(conn->flags);
-					best_match = conn;
-
-					continue; /* found a match - but maybe not yet the best */
+				if (conn_input_rank(conn, pkt, ip_hdr, proto,
+						    src_port, dst_port) < 0) {
+					continue;
 				}
 
 				/* If we have a multicast packet, and we found
@@ -1000,8 +1286,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 				 * clone the received pkt.
 				 */
 
-				NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
-					conn->user_data);
+				NET_DBG("[%p] mcast match found cb %p ud %p", conn,
+					conn->cb, conn->user_data);
 
 				mcast_pkt = net_pkt_clone(
 					pkt, K_MSEC(CONFIG_NET_CONN_PACKET_CLONE_TIMEOUT));
@@ -1010,8 +1296,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 					goto drop;
 				}
 
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
+				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr,
+					     conn->user_data) == NET_DROP) {
 					net_stats_update_per_proto_drop(pkt_iface, proto);
 					net_pkt_unref(mcast_pkt);
 				} else {
@@ -1021,22 +1307,20 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 				mcast_pkt_delivered = true;
 			}
 		}
-	} /* loop end */
 
-	if (best_match != NULL) {
-		cb = best_match->cb;
-		user_data = best_match->user_data;
-	}
-
-	k_mutex_unlock(&conn_lock);
+		k_mutex_unlock(&conn_lock);
 
-	if (is_mcast_pkt && mcast_pkt_delivered) {
-		/* As one or more multicast packets
-		 * have already been delivered in the loop above,
-		 * we shall not call the callback again here.
-		 */
-		net_pkt_unref(pkt);
-		return NET_OK;
+		if (mcast_pkt_delivered) {
+			/* As one or more multicast packets
+			 * have already been delivered in the loop above,
+			 * we shall not call the callback again here.
+			 */
+			net_pkt_unref(pkt);
+			return NET_OK;
+		}
+	} else {
+		best_match = conn_input_lookup(lists, pkt, ip_hdr, proto, src_port,
+					       dst_port, &cb, &user_data);
 	}
 
 	if (cb != NULL) {
@@ -1091,6 +1375,12 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_tuple_hash[i]);
+		sys_slist_init(&conn_port_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
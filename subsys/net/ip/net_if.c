@@ -212,6 +212,19 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+static int net_if_l2_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	/* Split the TCP packets carrying several segments, unless the
+	 * driver can do it.
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0 &&
+	    !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TX_TSO)) {
+		return net_tcp_gso_send(iface, pkt);
+	}
+
+	return net_if_l2(iface)->send(iface, pkt);
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = { 0 };
@@ -258,7 +271,7 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 
 		net_if_tx_lock(iface);
-		status = net_if_l2(iface)->send(iface, pkt);
+		status = net_if_l2_send(iface, pkt);
 		net_if_tx_unlock(iface);
 		if (status < 0) {
 			NET_WARN_RATELIMIT("iface %d pkt %p send failure status %d",
@@ -2091,6 +2091,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 #if defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_L2_IPIP)
 	net_pkt_set_remote_address(clone_pkt, net_pkt_remote_address(pkt),
@@ -2211,6 +2212,58 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 	return clone_pkt;
 }
 
+struct net_pkt *net_pkt_clone_segment(struct net_pkt *pkt, size_t hdr_len,
+				      size_t offset, size_t len,
+				      k_timeout_t timeout)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_pkt_cursor backup;
+	struct net_pkt *clone_pkt;
+	int ret;
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+	clone_pkt = pkt_alloc_with_buffer(pkt->slab, net_pkt_iface(pkt),
+					  hdr_len + len, NET_AF_UNSPEC, 0,
+					  timeout, __func__, __LINE__);
+#else
+	clone_pkt = pkt_alloc_with_buffer(pkt->slab, net_pkt_iface(pkt),
+					  hdr_len + len, NET_AF_UNSPEC, 0,
+					  timeout);
+#endif
+	if (!clone_pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	ret = net_pkt_copy(clone_pkt, pkt, hdr_len);
+	if (ret == 0) {
+		ret = net_pkt_skip(pkt, offset);
+	}
+
+	if (ret == 0) {
+		ret = net_pkt_copy(clone_pkt, pkt, len);
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	if (ret < 0) {
+		net_pkt_unref(clone_pkt);
+		return NULL;
+	}
+
+	clone_pkt_attributes(pkt, clone_pkt);
+	net_pkt_cursor_init(clone_pkt);
+
+	NET_DBG("Cloned %zu bytes at %zu of %p to %p", len, offset, pkt,
+		clone_pkt);
+
+	return clone_pkt;
+}
+
 size_t net_pkt_remaining_data(struct net_pkt *pkt)
 {
 	struct net_buf *buf;
@@ -267,15 +267,200 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct net_in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+/* Path compressed binary trie of the route prefixes. A node holds the routes
+ * of its prefix, if any, and its children extend the prefix with a 0 or a 1
+ * bit respectively. Nodes without routes are only kept where two branches
+ * meet, so the trie never needs more than two nodes per route.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+	sys_slist_t routes;
+	struct net_in6_addr prefix;
+	uint8_t prefix_len;
+};
+
+static struct route_trie_node route_trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *route_trie_free_nodes;
+static struct route_trie_node *route_trie_root;
+
+static inline uint8_t route_addr_bit(const struct net_in6_addr *addr, uint8_t bit)
+{
+	return (addr->s6_addr[bit / 8U] >> (7U - (bit % 8U))) & 1U;
+}
+
+/* Number of leading bits two addresses have in common, up to max_len */
+static uint8_t route_addr_common_len(const struct net_in6_addr *addr1,
+				     const struct net_in6_addr *addr2,
+				     uint8_t max_len)
+{
+	uint8_t len = 0U;
+
+	for (size_t i = 0; i < sizeof(addr1->s6_addr) && len < max_len; i++) {
+		uint8_t diff = addr1->s6_addr[i] ^ addr2->s6_addr[i];
+
+		if (diff != 0U) {
+			len += (uint8_t)(__builtin_clz(diff) - 24);
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct route_trie_node *route_trie_node_new(const struct net_in6_addr *prefix,
+						   uint8_t prefix_len)
+{
+	struct route_trie_node *node = route_trie_free_nodes;
+
+	NET_ASSERT(node, "Route trie nodes exhausted");
+
+	route_trie_free_nodes = node->child[0];
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	sys_slist_init(&node->routes);
+	net_ipv6_addr_prefix_mask(prefix->s6_addr, node->prefix.s6_addr, prefix_len);
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static void route_trie_node_free(struct route_trie_node *node)
+{
+	node->child[0] = route_trie_free_nodes;
+	route_trie_free_nodes = node;
+}
+
+static void route_trie_init(void)
+{
+	route_trie_root = NULL;
+	route_trie_free_nodes = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		route_trie_node_free(&route_trie_nodes[i]);
+	}
+}
+
+static void route_trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &route_trie_root;
+	struct route_trie_node *node, *leaf, *branch;
+	uint8_t prefix_len = route->prefix_len;
+	uint8_t common = 0U;
+
+	while ((node = *link) != NULL) {
+		common = route_addr_common_len(&node->prefix, &route->addr,
+					       MIN(node->prefix_len, prefix_len));
+		if (common < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			sys_slist_append(&node->routes, &route->trie_node);
+			return;
+		}
+
+		link = &node->child[route_addr_bit(&route->addr, node->prefix_len)];
+	}
+
+	leaf = route_trie_node_new(&route->addr, prefix_len);
+	sys_slist_append(&leaf->routes, &route->trie_node);
+
+	if (node == NULL) {
+		*link = leaf;
+		return;
+	}
+
+	if (common == prefix_len) {
+		/* The new prefix covers the one of the node */
+		leaf->child[route_addr_bit(&node->prefix, prefix_len)] = node;
+		*link = leaf;
+		return;
+	}
+
+	/* The prefixes diverge after their common bits */
+	branch = route_trie_node_new(&route->addr, common);
+	branch->child[route_addr_bit(&node->prefix, common)] = node;
+	branch->child[route_addr_bit(&route->addr, common)] = leaf;
+	*link = branch;
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &route_trie_root;
+	struct route_trie_node **parent_link = NULL;
+	struct route_trie_node *node, *parent;
+
+	while ((node = *link) != NULL && node->prefix_len < route->prefix_len) {
+		parent_link = link;
+		link = &node->child[route_addr_bit(&route->addr, node->prefix_len)];
+	}
+
+	if (node == NULL || node->prefix_len != route->prefix_len ||
+	    !sys_slist_find_and_remove(&node->routes, &route->trie_node)) {
+		return;
+	}
+
+	if (!sys_slist_is_empty(&node->routes) ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		return;
+	}
+
+	*link = node->child[0] != NULL ? node->child[0] : node->child[1];
+	route_trie_node_free(node);
+
+	if (*link != NULL || parent_link == NULL) {
+		return;
+	}
+
+	/* A parent without routes is not needed once left with one child */
+	parent = *parent_link;
+	if (sys_slist_is_empty(&parent->routes)) {
+		*parent_link = parent->child[0] != NULL ? parent->child[0] : parent->child[1];
+		route_trie_node_free(parent);
+	}
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  const struct net_in6_addr *dst)
+{
+	struct route_trie_node *node = route_trie_root;
+	struct net_route_entry *route, *found = NULL;
+
+	/* Prefixes only get longer along the path of the destination bits */
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr, node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[route_addr_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+#else
+static inline void route_trie_init(void) { }
+static inline void route_trie_insert(struct net_route_entry *route) { }
+static inline void route_trie_remove(struct net_route_entry *route) { }
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  const struct net_in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +483,93 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+struct route_cache_entry {
+	struct net_in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+	uint32_t generation;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+/* Cached lookups are only valid for the routing table generation they were
+ * done in. Entries start at generation 0, which is never current.
+ */
+static uint32_t route_generation = 1U;
+
+static struct route_cache_entry *route_cache_slot(const struct net_in6_addr *dst)
+{
+	uint32_t hash = 0U;
+
+	for (size_t i = 0; i < ARRAY_SIZE(dst->s6_addr32); i++) {
+		hash = (hash ^ UNALIGNED_GET(&dst->s6_addr32[i])) * 0x9e3779b1U;
+	}
+
+	return &route_cache[(hash ^ (hash >> 16)) % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static bool route_cache_get(struct net_if *iface, const struct net_in6_addr *dst,
+			    struct net_route_entry **route)
+{
+	struct route_cache_entry *entry = route_cache_slot(dst);
+
+	if (entry->generation != route_generation || entry->iface != iface ||
+	    !net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return false;
+	}
+
+	*route = entry->route;
+
+	return true;
+}
+
+static void route_cache_put(struct net_if *iface, const struct net_in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = route_cache_slot(dst);
+
+	net_ipaddr_copy(&entry->dst, dst);
+	entry->iface = iface;
+	entry->route = route;
+	entry->generation = route_generation;
+}
+
+static inline void route_cache_invalidate(void)
+{
+	if (++route_generation == 0U) {
+		route_generation = 1U;
+		memset(route_cache, 0, sizeof(route_cache));
+	}
+}
+#else
+static inline bool route_cache_get(struct net_if *iface, const struct net_in6_addr *dst,
+				   struct net_route_entry **route)
+{
+	return false;
+}
+
+static inline void route_cache_put(struct net_if *iface, const struct net_in6_addr *dst,
+				   struct net_route_entry *route) { }
+static inline void route_cache_invalidate(void) { }
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct net_in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	if (!route_cache_get(iface, dst, &found)) {
+		found = route_find(iface, dst);
+		route_cache_put(iface, dst, found);
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -445,6 +717,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
+	route_trie_insert(route);
+	route_cache_invalidate();
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -587,6 +861,8 @@ int net_route_del(struct net_route_entry *route)
 	}
 
 	sys_slist_find_and_remove(&routes, &route->node);
+	route_trie_remove(route);
+	route_cache_invalidate();
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -1155,5 +1431,7 @@ void net_route_init(void)
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
 #endif
+	route_trie_init();
+
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
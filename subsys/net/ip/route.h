@@ -49,6 +49,11 @@ struct net_route_entry {
 	 */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	/** Node in the list of routes of the same prefix in the route trie. */
+	sys_snode_t trie_node;
+#endif
+
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
 
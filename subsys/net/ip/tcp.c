@@ -59,15 +59,17 @@ static int tcp_tx_window =
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+/* Lower bound of the retransmission timeout derived from RTT measurements */
+#define TCP_RTO_MIN_MS 200
+
+/* Timestamps of a connection idle for longer are not compared (RFC 7323 ch 5.5) */
+#define TCP_PAWS_IDLE_MS (24U * 24U * 60U * 60U * MSEC_PER_SEC)
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
@@ -82,6 +84,7 @@ static K_KERNEL_STACK_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_STACK_SIZE);
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static bool is_destination_local(struct net_pkt *pkt);
 static void tcp_out(struct tcp *conn, uint8_t flags);
+static int tcp_send_data(struct tcp *conn);
 static const char *tcp_state_to_str(enum tcp_state state, bool prefix);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
@@ -473,6 +476,15 @@ out:
 
 static void tcp_derive_rto(struct tcp *conn)
 {
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->srtt != 0U) {
+		/* Measured round trip time is available, see RFC 6298 */
+		conn->rto = (uint16_t)CLAMP(conn->srtt + MAX(1U, 4U * conn->rttvar),
+					    MIN(TCP_RTO_MIN_MS, tcp_rto), UINT16_MAX);
+		return;
+	}
+#endif
+
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
 	uint32_t gain;
@@ -488,107 +500,194 @@ static void tcp_derive_rto(struct tcp *conn)
 	rto = (uint32_t)tcp_rto;
 	rto = (gain * rto) >> 9;
 	conn->rto = (uint16_t)rto;
+#elif defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->rto = (uint16_t)tcp_rto;
 #else
 	ARG_UNUSED(conn);
 #endif
 }
 
-#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-
-/* Implementation according to RFC6582 */
-
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+static uint32_t tcp_ts_now(struct tcp *conn)
 {
-	NET_DBG("[%p] ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
-		conn->ca.pending_fast_retransmit_bytes);
+	return k_uptime_get_32() + conn->ts_offset;
 }
 
-static void tcp_new_reno_init(struct tcp *conn)
+/* Round trip time estimation of RFC 6298 ch 2, in milliseconds */
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
 {
-	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
-	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
-	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
-}
+	uint32_t delta;
 
-static void tcp_new_reno_fast_retransmit(struct tcp *conn)
-{
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
-		/* Account for the lost segments */
-		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
-		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
+	rtt = MAX(rtt, 1U);
+
+	if (conn->srtt == 0U) {
+		conn->srtt = rtt;
+		conn->rttvar = rtt / 2U;
+	} else {
+		delta = (conn->srtt > rtt) ? (conn->srtt - rtt) : (rtt - conn->srtt);
+		conn->rttvar = (3U * conn->rttvar + delta) / 4U;
+		conn->srtt = (7U * conn->srtt + rtt) / 8U;
 	}
+
+	tcp_derive_rto(conn);
 }
 
-static void tcp_new_reno_timeout(struct tcp *conn)
+/* Every acknowledgment echoing one of our timestamps is an RTT sample */
+static void tcp_ts_rtt_sample(struct tcp *conn)
 {
-	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
-	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
+	uint32_t rtt;
+
+	if (!conn->ts_ok || !conn->recv_options.ts_found || conn->recv_options.tsecr == 0U) {
+		return;
+	}
+
+	rtt = tcp_ts_now(conn) - conn->recv_options.tsecr;
+	if ((int32_t)rtt >= 0) {
+		tcp_rtt_update(conn, rtt);
+	}
 }
 
-/* For every duplicate ack increment the cwnd by mss */
-static void tcp_new_reno_dup_ack(struct tcp *conn)
+/* PAWS check of RFC 7323 ch 5.3, and update of the timestamp to echo */
+static bool tcp_ts_check(struct tcp *conn, struct tcphdr *th)
 {
-	int32_t new_win = conn->ca.cwnd;
+	struct tcp_options *options = &conn->recv_options;
+	uint32_t now = k_uptime_get_32();
 
-	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	if (!conn->ts_ok || !options->ts_found ||
+	    conn->state == TCP_LISTEN || conn->state == TCP_SYN_SENT) {
+		return true;
+	}
+
+	/* A RST is never rejected for its timestamp (R1), its sequence
+	 * number alone decides whether it is acceptable.
+	 */
+	if (th_flags(th) & RST) {
+		return true;
+	}
+
+	if ((int32_t)(options->tsval - conn->ts_recent) < 0 &&
+	    (now - conn->ts_recent_time) < TCP_PAWS_IDLE_MS) {
+		return false;
+	}
+
+	if (net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0) {
+		conn->ts_recent = options->tsval;
+		conn->ts_recent_time = now;
+	}
+
+	return true;
+}
+#else
+static inline void tcp_ts_rtt_sample(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
 }
 
-static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
+static inline bool tcp_ts_check(struct tcp *conn, struct tcphdr *th)
 {
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+	ARG_UNUSED(conn);
+	ARG_UNUSED(th);
 
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		if (conn->ca.cwnd < conn->ca.ssthresh) {
-			new_win += win_inc;
-		} else {
-			/* Implement a div_ceil	to avoid rounding to 0 */
-			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
-		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	} else {
-		/* Check if it is still in fast recovery mode */
-		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
-			conn->ca.pending_fast_retransmit_bytes = 0;
-			conn->ca.cwnd = conn->ca.ssthresh;
-		} else {
-			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
-		}
-	}
-	tcp_new_reno_log(conn, "pkts_acked");
+	return true;
 }
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+
+/* The congestion control algorithms are in tcp_congestion.c */
 
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.rtt_timing = false;
+	conn->ca.snd_max = conn->seq;
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	/* Karn's algorithm, the RTT of retransmitted data is ambiguous */
+	conn->ca.rtt_timing = false;
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.rtt_timing = false;
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	uint32_t rtt = 0U;
+
+	if (conn->ca.rtt_timing &&
+	    net_tcp_seq_cmp(conn->seq + acked_len, conn->ca.rtt_seq) >= 0) {
+		rtt = MAX(k_uptime_get_32() - conn->ca.rtt_start, 1U);
+		conn->ca.rtt_timing = false;
+	}
+
+	conn->ca.ops->pkts_acked(conn, acked_len, rtt);
+}
+
+/* Time one segment of new data at a time */
+static void tcp_ca_data_sent(struct tcp *conn, uint32_t seq, uint32_t len)
+{
+	if (net_tcp_seq_cmp(seq, conn->ca.snd_max) < 0) {
+		if (conn->ca.rtt_timing && net_tcp_seq_cmp(seq, conn->ca.rtt_seq) < 0 &&
+		    net_tcp_seq_cmp(seq + len, conn->ca.rtt_seq) >= 0) {
+			conn->ca.rtt_timing = false;
+		}
+
+		return;
+	}
+
+	if (!conn->ca.rtt_timing) {
+		conn->ca.rtt_timing = true;
+		conn->ca.rtt_seq = seq + len;
+		conn->ca.rtt_start = k_uptime_get_32();
+	}
+
+	conn->ca.snd_max = seq + len;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, uint32_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	if (value == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	ops = tcp_ca_find(value, MIN(len, TCP_CA_NAME_MAX));
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	conn->ca.ops = ops;
+
+	/* Restart the congestion control of an established connection */
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		tcp_ca_init(conn);
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, uint32_t *len)
+{
+	if (value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, strlen(conn->ca.ops->name) + 1);
+	memcpy(value, conn->ca.ops->name, *len);
+
+	return 0;
 }
 #else
 
@@ -602,6 +701,11 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_data_sent(struct tcp *conn, uint32_t seq, uint32_t len) { }
+
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -1107,9 +1211,6 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -1157,6 +1258,47 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_num = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+						     NET_TCP_MAX_SACK_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_num; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].left =
+					net_ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].right =
+					net_ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+			}
+			break;
+#endif /* CONFIG_NET_TCP_SACK */
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval = net_ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr = net_ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
 		default:
 			continue;
 		}
@@ -1169,6 +1311,55 @@ end:
 	return result;
 }
 
+/* Forget the options which only apply to the previous segment */
+static void tcp_options_segment_reset(struct tcp_options *recv_options)
+{
+	recv_options->ts_found = false;
+#ifdef CONFIG_NET_TCP_SACK
+	recv_options->sack_num = 0;
+#endif
+}
+
+/* Options offered in our SYN */
+static void tcp_options_offer(struct tcp *conn)
+{
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK);
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS);
+}
+
+/* Options agreed with the SYN or the SYN-ACK of the peer. The peer only
+ * offers them back in its SYN-ACK if our SYN offered them.
+ */
+static void tcp_options_agree(struct tcp *conn)
+{
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) && conn->recv_options.sack_perm_found;
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) && conn->recv_options.ts_found;
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->ts_ok) {
+		conn->ts_recent = conn->recv_options.tsval;
+		conn->ts_recent_time = k_uptime_get_32();
+		tcp_ts_rtt_sample(conn);
+	}
+#endif
+}
+
+/* Length of the options of the data segments */
+static size_t tcp_data_options_len(struct tcp *conn)
+{
+	size_t len = 0;
+
+	if (conn->ts_ok) {
+		len += NET_TCP_TIMESTAMP_SIZE + 2;
+	}
+
+	if (conn->sack_ok && conn->queue_recv_data != NULL) {
+		len += NET_TCP_SACK_BLOCK_SIZE + 4;
+	}
+
+	return len;
+}
+
 static bool tcp_short_window(struct tcp *conn)
 {
 	int32_t threshold = MIN(conn_mss(conn), conn->recv_win_max / 2);
@@ -1347,7 +1538,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1361,11 +1552,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_sport));
 	UNALIGNED_PUT(conn->dst.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_dport));
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(net_htons(conn->recv_win), UNALIGNED_MEMBER_ADDR(th, th_win));
@@ -1426,23 +1613,58 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, uint32_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+/* Write the options of a segment, padded to a multiple of 4 bytes with NOPs */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *options)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	size_t len = 0;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	if (conn->send_options.mss_found) {
+		uint32_t recv_mss = net_tcp_get_supported_mss(conn);
+
+		recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+		UNALIGNED_PUT(net_htonl(recv_mss), (uint32_t *)&options[len]);
+		len += NET_TCP_MSS_SIZE;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) && conn->sack_ok && (flags & SYN)) {
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_SACK_PERM_OPT;
+		options[len++] = NET_TCP_SACK_PERM_SIZE;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->ts_ok) {
+		uint32_t tsecr = (flags & ACK) ? conn->ts_recent : 0U;
 
-	UNALIGNED_PUT(net_htonl(recv_mss), (uint32_t *)mss);
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_TIMESTAMP_OPT;
+		options[len++] = NET_TCP_TIMESTAMP_SIZE;
+		UNALIGNED_PUT(net_htonl(tcp_ts_now(conn)), (uint32_t *)&options[len]);
+		UNALIGNED_PUT(net_htonl(tsecr), (uint32_t *)&options[len + 4]);
+		len += NET_TCP_TIMESTAMP_SIZE - 2;
+	}
+#endif
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	/* The receive queue holds a single run of out of order data */
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) && conn->sack_ok && !(flags & SYN) &&
+	    (flags & ACK) && conn->queue_recv_data != NULL) {
+		uint32_t left = tcp_get_seq(conn->queue_recv_data);
+		uint32_t right = left + net_buf_frags_len(conn->queue_recv_data);
+
+		if (net_tcp_seq_cmp(left, conn->ack) > 0) {
+			options[len++] = NET_TCP_NOP_OPT;
+			options[len++] = NET_TCP_NOP_OPT;
+			options[len++] = NET_TCP_SACK_OPT;
+			options[len++] = NET_TCP_SACK_BLOCK_SIZE + 2;
+			UNALIGNED_PUT(net_htonl(left), (uint32_t *)&options[len]);
+			UNALIGNED_PUT(net_htonl(right), (uint32_t *)&options[len + 4]);
+			len += NET_TCP_SACK_BLOCK_SIZE;
+		}
+	}
+
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1557,14 +1779,12 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[NET_TCP_MAX_OPT_SIZE];
+	size_t options_len = tcp_options_build(conn, flags, options);
+	size_t alloc_len = sizeof(struct tcphdr) + options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1575,6 +1795,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -1583,14 +1804,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1814,13 +2035,228 @@ static void tcp_setup_retransmission(struct tcp *conn)
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Forget the blocks which have been acknowledged cumulatively */
+static void tcp_sack_trim(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_sack_block *board = conn->sack_board;
+	int acked = 0;
+
+	while (acked < conn->sack_board_num && net_tcp_seq_cmp(board[acked].right, ack) <= 0) {
+		acked++;
+	}
+
+	conn->sack_board_num -= acked;
+	memmove(board, &board[acked], conn->sack_board_num * sizeof(*board));
+
+	if (conn->sack_board_num > 0 && net_tcp_seq_cmp(board[0].left, ack) < 0) {
+		board[0].left = ack;
+	}
+}
+
+/* Add a block to the scoreboard, merging it with the ones it overlaps or touches */
+static void tcp_sack_insert(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack_block *board = conn->sack_board;
+	int num = conn->sack_board_num;
+	int first = 0;
+	int last;
+
+	while (first < num && net_tcp_seq_cmp(board[first].right, left) < 0) {
+		first++;
+	}
+
+	for (last = first; last < num && net_tcp_seq_cmp(board[last].left, right) <= 0; last++) {
+		if (net_tcp_seq_cmp(board[last].left, left) < 0) {
+			left = board[last].left;
+		}
+
+		if (net_tcp_seq_cmp(board[last].right, right) > 0) {
+			right = board[last].right;
+		}
+	}
+
+	if (first == last) {
+		/* When full, the highest block is the least useful one */
+		if (num == TCP_SACK_SCOREBOARD_SIZE) {
+			if (first == num) {
+				return;
+			}
+
+			num--;
+		}
+
+		memmove(&board[first + 1], &board[first], (num - first) * sizeof(*board));
+		num++;
+	} else {
+		memmove(&board[first + 1], &board[last], (num - last) * sizeof(*board));
+		num -= last - first - 1;
+	}
+
+	board[first].left = left;
+	board[first].right = right;
+	conn->sack_board_num = num;
+}
+
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_options *options = &conn->recv_options;
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	tcp_sack_trim(conn, ack);
+
+	for (int i = 0; i < options->sack_num; i++) {
+		uint32_t left = options->sack[i].left;
+		uint32_t right = options->sack[i].right;
+
+		/* Ignore duplicate (RFC 2883) and invalid blocks */
+		if (net_tcp_seq_cmp(left, ack) < 0 || net_tcp_seq_cmp(right, left) <= 0 ||
+		    net_tcp_seq_cmp(right, snd_max) > 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, left, right);
+	}
+}
+
+/* The peer may discard the data it reported after a timeout (RFC 2018 ch 8) */
+static void tcp_sack_clear(struct tcp *conn)
+{
+	conn->sack_board_num = 0;
+}
+
+/* Skip the data held by the peer, and stop the segment before the next data it holds */
+static int tcp_sack_next(struct tcp *conn, int len)
+{
+	uint32_t next = conn->seq + conn->unacked_len;
+
+	for (int i = 0; i < conn->sack_board_num; i++) {
+		struct tcp_sack_block *block = &conn->sack_board[i];
+
+		if (net_tcp_seq_cmp(block->right, next) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block->left, next) <= 0) {
+			conn->unacked_len += block->right - next;
+			next = block->right;
+			continue;
+		}
+
+		return MIN(len, (int)(block->left - next));
+	}
+
+	return len;
+}
+
+/* After a partial acknowledgment, the data at the ACK is considered lost if
+ * enough data above it has been received (RFC 6675 ch 4), resend it.
+ */
+static void tcp_sack_recover(struct tcp *conn)
+{
+	uint32_t sacked = 0U;
+	int unacked_len;
+
+	if (conn->sack_board_num == 0 || conn->unacked_len == 0) {
+		return;
+	}
+
+	for (int i = 0; i < conn->sack_board_num; i++) {
+		sacked += conn->sack_board[i].right - conn->sack_board[i].left;
+	}
+
+	if (sacked < DUPLICATE_ACK_RETRANSMIT_TRHESHOLD * conn_mss(conn)) {
+		return;
+	}
+
+	unacked_len = conn->unacked_len;
+	conn->unacked_len = 0;
+
+	/* Resend one segment of the hole, as a retransmission */
+	conn->data_mode = TCP_DATA_MODE_RESEND;
+	(void)tcp_send_data(conn);
+	conn->data_mode = TCP_DATA_MODE_SEND;
+
+	conn->unacked_len = unacked_len;
+}
+#else
+static inline void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ack);
+}
+
+static inline void tcp_sack_clear(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static inline int tcp_sack_next(struct tcp *conn, int len)
+{
+	ARG_UNUSED(conn);
+
+	return len;
+}
+
+static inline void tcp_sack_recover(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* The IP length fields limit the size of a packet holding several segments */
+#define TCP_GSO_MAX_LEN (UINT16_MAX - NET_IPV4H_LEN - NET_IPV4_HDR_OPTNS_MAX_LEN - \
+			 NET_TCPH_LEN - NET_TCP_MAX_OPT_SIZE)
+
+/* Length of the data to put in one packet, which is split into segments of
+ * seg_len bytes before transmission. Retransmissions, including the SACK
+ * recovery ones, and the data looped back to a local address, are sent one
+ * segment at a time.
+ */
+static int tcp_gso_len(struct tcp *conn, int seg_len)
+{
+	if (conn->data_mode == TCP_DATA_MODE_RESEND || seg_len <= 0 ||
+	    net_if_l2(conn->iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return seg_len;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && conn->dst.sa.sa_family == NET_AF_INET &&
+	    net_ipv4_is_my_addr(&conn->dst.sin.sin_addr)) {
+		return seg_len;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->dst.sa.sa_family == NET_AF_INET6 &&
+	    net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr)) {
+		return seg_len;
+	}
+
+	return seg_len * MIN(CONFIG_NET_TCP_GSO_MAX_SEGS, TCP_GSO_MAX_LEN / seg_len);
+}
+#else
+static inline int tcp_gso_len(struct tcp *conn, int seg_len)
+{
+	ARG_UNUSED(conn);
+
+	return seg_len;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
+	int seg_len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	/* The MSS does not account for the TCP options */
+	seg_len = conn_mss(conn) - (int)tcp_data_options_len(conn);
+	len = tcp_sack_next(conn, tcp_gso_len(conn, seg_len));
+	len = MIN(tcp_unsent_len(conn), len);
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1845,8 +2281,13 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
+	if (len > seg_len) {
+		net_pkt_set_gso_size(pkt, seg_len);
+	}
+
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
+		tcp_ca_data_sent(conn, conn->seq + conn->unacked_len, len);
 		conn->unacked_len += len;
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
@@ -1971,6 +2412,7 @@ static void tcp_resend_data(struct k_work *work)
 
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
+		tcp_sack_clear(conn);
 
 		ret = tcp_send_data(conn);
 		if (ret == -ENODATA) {
@@ -2189,6 +2631,10 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	/* Do not disclose the uptime through the timestamps */
+	conn->ts_offset = sys_rand32_get();
+#endif
 	conn->recv_win_max = tcp_rx_window;
 	conn->recv_win = conn->recv_win_max;
 	conn->recv_win_sent = conn->recv_win_max;
@@ -2204,6 +2650,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.ops = tcp_ca_find(NULL, 0);
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2999,6 +3446,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	tcp_options_segment_reset(&conn->recv_options);
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("[%p] DROP: Invalid TCP option list", conn);
@@ -3008,6 +3457,14 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (!tcp_ts_check(conn, th)) {
+		NET_DBG("[%p] DROP: Old timestamp", conn);
+		net_stats_update_tcp_seg_drop(conn->iface);
+		tcp_out(conn, ACK);
+		k_mutex_unlock(&conn->lock);
+		return NET_DROP;
+	}
+
 	if ((conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT) && FL(&fl, &, SYN)) {
 		/* According to RFC 793, ch 3.9 Event Processing, receiving SYN
 		 * once the connection has been established is an error
@@ -3094,6 +3551,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_options_agree(conn);
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
@@ -3123,6 +3581,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+				conn->ca.ops = conn->accepted_conn->ca.ops;
+#endif
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3207,6 +3668,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			k_work_cancel_delayable(&conn->send_data_timer);
+			tcp_options_agree(conn);
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
@@ -3252,6 +3714,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		keep_alive_timer_restart(conn);
 
+		tcp_sack_update(conn, th_ack(th));
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3331,6 +3795,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
+			tcp_ts_rtt_sample(conn);
 
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
@@ -3349,6 +3814,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				tcp_setup_retransmission(conn);
 			}
 
+			tcp_sack_recover(conn);
+
 			/* We are closing the connection, send a FIN to peer */
 			if (conn->in_close && conn->send_data_total == 0) {
 				if (fin) {
@@ -3913,6 +4380,7 @@ static int tcp_start_handshake(struct tcp *conn)
 	k_mutex_lock(&conn->lock, K_FOREVER);
 	tcp_check_sock_options(conn);
 	conn->send_options.mss_found = true;
+	tcp_options_offer(conn);
 	ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 	if (ret < 0) {
 		k_mutex_unlock(&conn->lock);
@@ -4217,7 +4685,11 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* The checksum of a packet holding several segments is computed
+	 * for each segment when it is split.
+	 */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) &&
+	     net_pkt_gso_size(pkt) == 0U) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4225,6 +4697,94 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	size_t gso_size = net_pkt_gso_size(pkt);
+	struct tcphdr *th = th_get(pkt);
+	size_t hdr_len, data_len;
+	uint32_t seq;
+	uint8_t flags;
+	int sent = 0;
+	int ret;
+
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	/* The headers are copied to every segment, only the sequence
+	 * number, the flags, the lengths and the checksums differ.
+	 */
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) + th_off(th) * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+	seq = th_seq(th);
+	flags = th_flags(th);
+
+	for (size_t offset = 0; offset < data_len; offset += gso_size) {
+		size_t len = MIN(gso_size, data_len - offset);
+		struct net_pkt *seg;
+
+		/* This runs with the TX lock of the interface held, never
+		 * wait for buffers.
+		 */
+		seg = net_pkt_clone_segment(pkt, hdr_len, offset, len, K_NO_WAIT);
+		if (!seg) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		net_pkt_set_gso_size(seg, 0U);
+
+		th = th_get(seg);
+		if (!th) {
+			net_pkt_unref(seg);
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		UNALIGNED_PUT(net_htonl(seq + offset), UNALIGNED_MEMBER_ADDR(th, th_seq));
+
+		if (offset + len < data_len) {
+			UNALIGNED_PUT((uint8_t)(flags & ~(PSH | FIN)), &th->th_flags);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == NET_AF_INET) {
+			NET_IPV4_HDR(seg)->chksum = 0U;
+		}
+
+		ret = tcp_finalize_pkt(seg);
+		if (ret == 0) {
+			ret = net_if_l2(iface)->send(iface, seg);
+		}
+
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto out;
+		}
+
+		sent += ret;
+	}
+
+	ret = 0;
+out:
+	if (ret < 0) {
+		NET_DBG("Cannot send segment of %p (%d)", pkt, ret);
+
+		/* The segments not sent are dropped, like on a congested link,
+		 * and recovered by the retransmissions. Without any segment
+		 * sent, the caller drops the packet.
+		 */
+		if (sent == 0) {
+			return ret;
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -4683,6 +5243,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4720,6 +5283,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -0,0 +1,414 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control algorithms, selected per connection with the
+ * TCP_CONGESTION socket option. The congestion window is kept in bytes.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "tcp_internal.h"
+
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+static void tcp_ca_log(struct tcp *conn, char *step)
+{
+	NET_DBG("[%p] %s %s, cwnd=%d, ssthres=%d, fast_pend=%i",
+		conn, conn->ca.ops->name, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.pending_fast_retransmit_bytes);
+}
+
+static void tcp_ca_cwnd_set(struct tcp *conn, uint32_t cwnd)
+{
+	conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+}
+
+/* Deflate the window after the fast retransmit, return false once the
+ * data outstanding at the time of the loss has been acknowledged.
+ */
+static bool tcp_ca_in_recovery(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		return false;
+	}
+
+	if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+		conn->ca.pending_fast_retransmit_bytes = 0;
+		conn->ca.cwnd = conn->ca.ssthresh;
+	} else {
+		conn->ca.pending_fast_retransmit_bytes -= acked_len;
+		conn->ca.cwnd -= acked_len;
+	}
+
+	return true;
+}
+
+static void tcp_ca_slow_start(struct tcp *conn, uint32_t acked_len)
+{
+	tcp_ca_cwnd_set(conn, conn->ca.cwnd + MIN(acked_len, conn_mss(conn)));
+}
+
+/* Implementation according to RFC6582 */
+
+static void tcp_new_reno_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_ca_log(conn, "init");
+}
+
+static void tcp_new_reno_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_ca_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_new_reno_timeout(struct tcp *conn)
+{
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+/* For every duplicate ack increment the cwnd by mss */
+static void tcp_new_reno_dup_ack(struct tcp *conn)
+{
+	tcp_ca_cwnd_set(conn, conn->ca.cwnd + conn_mss(conn));
+	tcp_ca_log(conn, "dup_ack");
+}
+
+static void tcp_new_reno_increase(struct tcp *conn, uint32_t acked_len)
+{
+	uint32_t win_inc = MIN(acked_len, conn_mss(conn));
+
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		tcp_ca_slow_start(conn, acked_len);
+	} else {
+		/* Implement a div_ceil	to avoid rounding to 0 */
+		tcp_ca_cwnd_set(conn, conn->ca.cwnd + ((win_inc * win_inc) + conn->ca.cwnd - 1) /
+						       conn->ca.cwnd);
+	}
+}
+
+static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt)
+{
+	ARG_UNUSED(rtt);
+
+	if (!tcp_ca_in_recovery(conn, acked_len)) {
+		tcp_new_reno_increase(conn, acked_len);
+	}
+
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_ca_new_reno = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+
+/* Implementation according to RFC9438, with C = 0.4 and beta = 0.7 */
+
+/* K^3 in ms^3 for a window reduction of one segment, (1 / C) * 10^9 */
+#define CUBIC_K_SCALE 2500000000ULL
+
+/* The window stops growing much earlier, this bounds the computations */
+#define CUBIC_T_MAX_MS 50000
+
+/* Window increase of the Reno-friendly region, 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_ALPHA_NUM 9U
+#define CUBIC_ALPHA_DEN 17U
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint32_t low = 0U;
+	uint32_t high = 2097152U; /* 2^21, (2^21)^3 = 2^63 */
+
+	while (low < high) {
+		uint32_t mid = low + (high - low + 1U) / 2U;
+
+		if ((uint64_t)mid * mid * mid <= a) {
+			low = mid;
+		} else {
+			high = mid - 1U;
+		}
+	}
+
+	return low;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	tcp_new_reno_init(conn);
+
+	/* Slow start until the first loss (RFC 5681 ch 3.1) */
+	conn->ca.ssthresh = UINT16_MAX;
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+}
+
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+
+	/* Fast convergence, release bandwidth to the new flows */
+	if (cwnd < cubic->w_max) {
+		cubic->w_max = cwnd * 17U / 20U;
+	} else {
+		cubic->w_max = cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2U, cwnd * 7U / 10U);
+	cubic->epoch_start = 0U;
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_ca_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+static void tcp_cubic_increase(struct tcp *conn, uint32_t acked_len, uint32_t rtt)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	uint32_t alpha_num = CUBIC_ALPHA_NUM;
+	uint32_t alpha_den = CUBIC_ALPHA_DEN;
+	int64_t target;
+	int64_t t;
+
+	if (cubic->epoch_start == 0U) {
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			cubic->k = cubic_root((cubic->w_max - cwnd) * CUBIC_K_SCALE / mss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0U;
+			cubic->origin = cwnd;
+		}
+	}
+
+	/* Window expected one RTT from now */
+	t = (int64_t)(now - cubic->epoch_start) + rtt - cubic->k;
+	t = CLAMP(t, -CUBIC_T_MAX_MS, CUBIC_T_MAX_MS);
+
+	target = cubic->origin + (t * t * t / 1000) * 4 * mss / 10000000;
+	target = CLAMP(target, cwnd, cwnd + cwnd / 2U);
+
+	/* Follow Reno at least, with the same average throughput */
+	if (cubic->w_est >= cubic->w_max) {
+		alpha_num = 1U;
+		alpha_den = 1U;
+	}
+
+	cubic->w_est += MAX((uint32_t)((uint64_t)acked_len * mss * alpha_num /
+				       (alpha_den * cwnd)), 1U);
+	cubic->w_est = MIN(cubic->w_est, UINT16_MAX);
+
+	if (cubic->w_est > target) {
+		tcp_ca_cwnd_set(conn, cubic->w_est);
+	} else {
+		tcp_ca_cwnd_set(conn, cwnd + (target - cwnd) * acked_len / cwnd);
+	}
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt)
+{
+	if (tcp_ca_in_recovery(conn, acked_len)) {
+		/* The epoch starts once the recovery is over */
+	} else if (conn->ca.cwnd < conn->ca.ssthresh) {
+		tcp_ca_slow_start(conn, acked_len);
+	} else {
+		tcp_cubic_increase(conn, acked_len, rtt);
+	}
+
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_ca_cubic = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+#ifdef CONFIG_NET_TCP_CONGESTION_VEGAS
+
+/* Delay-based congestion avoidance of TCP Vegas. Once per round trip, the
+ * amount of data queued in the network is estimated from the difference
+ * between the lowest RTT of the round and the lowest RTT of the connection,
+ * and the window is kept so that between alpha and beta segments are queued.
+ * Losses are handled as by New Reno.
+ */
+
+#define VEGAS_ALPHA 2U
+#define VEGAS_BETA 4U
+#define VEGAS_GAMMA 1U
+
+static void tcp_vegas_init(struct tcp *conn)
+{
+	tcp_new_reno_init(conn);
+
+	/* Vegas leaves slow start itself when the queue builds up */
+	conn->ca.ssthresh = UINT16_MAX;
+	memset(&conn->ca.vegas, 0, sizeof(conn->ca.vegas));
+	conn->ca.vegas.round_seq = conn->seq;
+}
+
+static void tcp_vegas_round(struct tcp *conn)
+{
+	struct tcp_ca_vegas *vegas = &conn->ca.vegas;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t queued;
+
+	queued = (uint32_t)((uint64_t)cwnd * (vegas->min_rtt - vegas->base_rtt) /
+			    vegas->min_rtt);
+
+	if (cwnd < conn->ca.ssthresh) {
+		if (queued > VEGAS_GAMMA * mss) {
+			/* Leave slow start with the window matching the base RTT */
+			cwnd = MIN(cwnd, (uint32_t)((uint64_t)cwnd * vegas->base_rtt /
+						    vegas->min_rtt) + mss);
+			conn->ca.cwnd = MAX(cwnd, mss * 2U);
+			conn->ca.ssthresh = conn->ca.cwnd;
+		}
+	} else if (queued < VEGAS_ALPHA * mss) {
+		tcp_ca_cwnd_set(conn, cwnd + mss);
+	} else if (queued > VEGAS_BETA * mss) {
+		conn->ca.cwnd = MAX(cwnd - mss, mss * 2U);
+	}
+}
+
+static void tcp_vegas_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt)
+{
+	struct tcp_ca_vegas *vegas = &conn->ca.vegas;
+	uint32_t ack = conn->seq + acked_len;
+
+	if (rtt != 0U) {
+		if (vegas->base_rtt == 0U || rtt < vegas->base_rtt) {
+			vegas->base_rtt = rtt;
+		}
+
+		if (vegas->min_rtt == 0U || rtt < vegas->min_rtt) {
+			vegas->min_rtt = rtt;
+		}
+	}
+
+	if (tcp_ca_in_recovery(conn, acked_len)) {
+		goto out;
+	}
+
+	if (vegas->base_rtt == 0U) {
+		/* No RTT measured yet */
+		tcp_new_reno_increase(conn, acked_len);
+		goto out;
+	}
+
+	if (net_tcp_seq_cmp(ack, vegas->round_seq) >= 0) {
+		/* A round trip is over when the data sent at its start is acked */
+		vegas->round_seq = conn->seq + conn->unacked_len;
+
+		if (vegas->min_rtt == 0U) {
+			/* No sample in this round, keep the last estimate */
+			vegas->min_rtt = vegas->last_min_rtt;
+		}
+
+		tcp_vegas_round(conn);
+		vegas->last_min_rtt = vegas->min_rtt;
+		vegas->min_rtt = 0U;
+	}
+
+	/* In congestion avoidance the window only changes once per round */
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		tcp_ca_slow_start(conn, acked_len);
+	}
+
+out:
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_ca_vegas = {
+	.name = "vegas",
+	.init = tcp_vegas_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_vegas_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_VEGAS */
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT tcp_ca_cubic
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_VEGAS)
+#define TCP_CA_DEFAULT tcp_ca_vegas
+#else
+#define TCP_CA_DEFAULT tcp_ca_new_reno
+#endif
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_ca_new_reno,
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	&tcp_ca_cubic,
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_VEGAS
+	&tcp_ca_vegas,
+#endif
+};
+
+const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	if (name == NULL) {
+		return &TCP_CA_DEFAULT;
+	}
+
+	len = strnlen(name, len);
+
+	ARRAY_FOR_EACH(tcp_ca_algorithms, i) {
+		const char *ca_name = tcp_ca_algorithms[i]->name;
+
+		if (strlen(ca_name) == len && memcmp(ca_name, name, len) == 0) {
+			return tcp_ca_algorithms[i];
+		}
+	}
+
+	return NULL;
+}
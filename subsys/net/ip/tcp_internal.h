@@ -50,6 +50,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -278,6 +279,32 @@ static inline int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 }
 #endif
 
+/**
+ * @brief Split a TCP packet into segments and send them
+ *
+ * @details Each segment carries net_pkt_gso_size() bytes of the packet
+ * data at most, and is passed to the L2 of the interface. Segments are
+ * allocated without waiting. From the first one which cannot be allocated
+ * or sent, the remaining segments are dropped.
+ *
+ * @param iface Network interface
+ * @param pkt Network packet, released unless an error is returned
+ *
+ * @return Number of bytes sent if at least one segment was sent, negative
+ * errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Return struct net_tcp_hdr pointer
  *
@@ -372,8 +399,6 @@ static inline int net_tcp_put(struct net_context *context, bool force_close)
 }
 #endif
 
-#define NET_TCP_MAX_OPT_SIZE  8
-
 #if defined(CONFIG_NET_NATIVE_TCP)
 void net_tcp_init(void);
 #else
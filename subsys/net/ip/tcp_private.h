@@ -194,10 +194,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_CLOSED,
@@ -229,31 +225,109 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+#define NET_TCP_MAX_OPT_SIZE      40
+#define NET_TCP_MAX_SACK_BLOCKS   4
+
+/* Number of SACK blocks remembered by the sender */
+#define TCP_SACK_SCOREBOARD_SIZE  8
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+	uint8_t sack_num;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
 };
 
+struct tcp;
+typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
+/* Longest name of a congestion control algorithm, including the NUL */
+#define TCP_CA_NAME_MAX 16
+
+/* Congestion control algorithm, see tcp_congestion.c */
+struct tcp_ca_ops {
+	/* Name selected with the TCP_CONGESTION socket option */
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	/* Called before conn->seq is advanced. The RTT in milliseconds of
+	 * the acknowledged data is 0 if it has not been measured.
+	 */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len, uint32_t rtt);
+};
+
+struct tcp_ca_cubic {
+	uint32_t epoch_start;
+	uint32_t k;
+	uint32_t w_est;
+	uint16_t w_max;
+	uint16_t origin;
+};
+
+struct tcp_ca_vegas {
+	uint32_t base_rtt;
+	/* Lowest RTT of the current round, and of the last completed one */
+	uint32_t min_rtt;
+	uint32_t last_min_rtt;
+	uint32_t round_seq;
+};
+
+struct tcp_collision_avoidance {
+	const struct tcp_ca_ops *ops;
 	uint16_t cwnd;
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
-};
+	/* Round trip time measurement of one segment at a time (Karn) */
+	bool rtt_timing;
+	uint32_t rtt_seq;
+	uint32_t rtt_start;
+	uint32_t snd_max;
+	union {
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+		struct tcp_ca_cubic cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_VEGAS
+		struct tcp_ca_vegas vegas;
 #endif
+		uint8_t unused;
+	};
+};
 
-struct tcp;
-typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+/* Congestion control algorithm of the given name, the default one if NULL */
+const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len);
+#endif
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
@@ -331,11 +405,23 @@ struct tcp { /* TCP connection */
 	uint16_t recv_win;
 	uint16_t send_win_max;
 	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_collision_avoidance ca;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	/* Data held by the peer above the ACK, sorted by sequence number */
+	struct tcp_sack_block sack_board[TCP_SACK_SCOREBOARD_SIZE];
+	uint8_t sack_board_num;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	uint32_t ts_offset;
+	uint32_t ts_recent;
+	uint32_t ts_recent_time;
+	uint32_t srtt;
+	uint32_t rttvar;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -350,6 +436,8 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+	bool sack_ok : 1;
+	bool ts_ok : 1;
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
+#include <zephyr/zvfs/epoll.h>
 #include <zephyr/zvfs/eventfd.h>
 
 static int init_socket_service(void);
@@ -31,6 +32,10 @@ STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 static struct service {
 	struct zsock_pollfd events[CONFIG_ZVFS_POLL_MAX];
 	int count;
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	struct zvfs_epoll_event ready[CONFIG_ZVFS_POLL_MAX];
+	int epfd;
+#endif
 } ctx;
 
 #define get_idx(svc) (*(svc->idx))
@@ -165,6 +170,60 @@ static int trigger_work(struct zsock_pollfd *pev)
 	return call_work(pev, event);
 }
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+/* Rebuild the interest list from the poll array, the epoll data is the
+ * index of the entry in ctx.events.
+ */
+static int service_epoll_setup(int count)
+{
+	struct zvfs_epoll_event ev;
+
+	if (ctx.epfd >= 0) {
+		(void)zvfs_close(ctx.epfd);
+	}
+
+	ctx.epfd = zvfs_epoll_create(0);
+	if (ctx.epfd < 0) {
+		return -errno;
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (ctx.events[i].fd < 0) {
+			continue;
+		}
+
+		ev.events = ctx.events[i].events;
+		ev.data.u32 = i;
+
+		if (zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_ADD, ctx.events[i].fd, &ev) < 0) {
+			return -errno;
+		}
+	}
+
+	return 0;
+}
+
+static int service_wait(int count)
+{
+	int ret;
+
+	ARG_UNUSED(count);
+
+	ret = zvfs_epoll_wait(ctx.epfd, ctx.ready, ARRAY_SIZE(ctx.ready), -1);
+
+	for (int i = 0; i < ret; i++) {
+		ctx.events[ctx.ready[i].data.u32].revents = ctx.ready[i].events;
+	}
+
+	return ret;
+}
+#else
+static int service_wait(int count)
+{
+	return zsock_poll(ctx.events, count, -1);
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
 static void socket_service_thread(void *p1, void *p2, void *p3)
 {
 	ARG_UNUSED(p1);
@@ -217,6 +276,10 @@ static void socket_service_thread(void *p1, void *p2, void *p3)
 	ctx.events[0].fd = fd;
 	ctx.events[0].events = ZSOCK_POLLIN;
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	ctx.epfd = -1;
+#endif
+
 restart:
 	i = 1;
 
@@ -231,8 +294,16 @@ restart:
 
 	k_mutex_unlock(&lock);
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	ret = service_epoll_setup(count + 1);
+	if (ret < 0) {
+		NET_ERR("epoll setup failed (%d)", ret);
+		goto out;
+	}
+#endif
+
 	while (true) {
-		ret = zsock_poll(ctx.events, count + 1, -1);
+		ret = service_wait(count + 1);
 		if (ret < 0) {
 			ret = -errno;
 			NET_ERR("poll failed (%d)", ret);
@@ -256,6 +327,9 @@ restart:
 					NET_DBG("Triggering work failed (%d)", ret);
 					goto restart;
 				}
+
+				/* epoll only sets the entries that are ready */
+				ctx.events[i].revents = 0;
 			}
 		}
 
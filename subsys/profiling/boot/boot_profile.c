@@ -0,0 +1,154 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/linker/sections.h>
+#include <zephyr/profiling/boot_profile.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+
+#include "boot_profile_internal.h"
+
+/* Records are written from boot code running before demand paging is
+ * initialized, so keep them pinned.
+ */
+__pinned_bss
+static struct boot_profile_record phases[BOOT_PROFILE_PHASE_COUNT];
+
+__pinned_bss
+static struct boot_profile_record entries[CONFIG_PROFILING_BOOT_MAX_ENTRIES];
+
+__pinned_bss
+static atomic_t num_entries;
+
+static const char *const phase_names[] = {
+	[BOOT_PROFILE_PHASE_BSS_ZERO] = "bss_zero",
+	[BOOT_PROFILE_PHASE_DATA_COPY] = "data_copy",
+	[BOOT_PROFILE_PHASE_ARCH_INIT] = "arch_init",
+	[BOOT_PROFILE_PHASE_PRE_KERNEL] = "pre_kernel",
+	[BOOT_PROFILE_PHASE_POST_KERNEL] = "post_kernel",
+};
+
+BUILD_ASSERT(ARRAY_SIZE(phase_names) == BOOT_PROFILE_PHASE_COUNT);
+
+static const char *const level_names[] = {
+	"EARLY", "PRE_KERNEL_1", "PRE_KERNEL_2", "POST_KERNEL", "APPLICATION", "SMP",
+};
+
+__weak __pinned_func
+uint32_t boot_profile_timestamp(void)
+{
+	return k_cycle_get_32();
+}
+
+__pinned_func
+void boot_profile_phase_record(enum boot_profile_phase phase, uint32_t start)
+{
+	phases[phase].start = start;
+	phases[phase].cycles = boot_profile_timestamp() - start;
+}
+
+__pinned_func
+void boot_profile_entry_record(const struct init_entry *entry, int level, uint32_t start,
+			       int result)
+{
+	uint32_t end = boot_profile_timestamp();
+	atomic_val_t idx = atomic_inc(&num_entries);
+	struct boot_profile_record *record;
+
+	if (idx >= CONFIG_PROFILING_BOOT_MAX_ENTRIES) {
+		return;
+	}
+
+	record = &entries[idx];
+	record->entry = entry;
+	record->start = start;
+	record->cycles = end - start;
+	record->result = (int16_t)result;
+	record->level = (uint8_t)level;
+}
+
+const struct boot_profile_record *boot_profile_phase_get(enum boot_profile_phase phase)
+{
+	return &phases[phase];
+}
+
+size_t boot_profile_entries_get(const struct boot_profile_record **records)
+{
+	*records = entries;
+
+	return MIN((size_t)atomic_get(&num_entries), CONFIG_PROFILING_BOOT_MAX_ENTRIES);
+}
+
+const char *boot_profile_name(const struct boot_profile_record *record)
+{
+	const struct init_entry *entry = record->entry;
+
+	if (entry == NULL) {
+		return phase_names[record - phases];
+	}
+
+	if (entry->dev != NULL) {
+		return entry->dev->name;
+	}
+
+	return entry->fn_name;
+}
+
+const char *z_boot_profile_level_name(const struct boot_profile_record *record)
+{
+	if ((record->entry == NULL) || (record->level >= ARRAY_SIZE(level_names))) {
+		return "";
+	}
+
+	return level_names[record->level];
+}
+
+void z_boot_profile_dump(boot_profile_print_t print, void *ctx)
+{
+	const struct boot_profile_record *records;
+	size_t count = boot_profile_entries_get(&records);
+
+	print(ctx, "boot_profile,%u,%u\n", BOOT_PROFILE_DUMP_VERSION,
+	      sys_clock_hw_cycles_per_sec());
+
+	for (size_t i = 0; i < BOOT_PROFILE_PHASE_COUNT; i++) {
+		print(ctx, "phase,%s,,,%llu,%u,\n", boot_profile_name(&phases[i]),
+		      k_cyc_to_us_floor64(phases[i].start), k_cyc_to_us_floor32(phases[i].cycles));
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		const struct boot_profile_record *record = &records[i];
+
+		print(ctx, "%s,%s,%s,%u,%llu,%u,%d\n",
+		      (record->entry->dev != NULL) ? "device" : "sys_init",
+		      boot_profile_name(record), z_boot_profile_level_name(record),
+		      record->entry->priority, k_cyc_to_us_floor64(record->start),
+		      k_cyc_to_us_floor32(record->cycles), record->result);
+	}
+
+	print(ctx, "boot_profile,end\n");
+}
+
+static void printk_print(void *ctx, const char *fmt, ...)
+{
+	va_list ap;
+
+	ARG_UNUSED(ctx);
+
+	va_start(ap, fmt);
+	vprintk(fmt, ap);
+	va_end(ap);
+}
+
+void boot_profile_dump(void)
+{
+	z_boot_profile_dump(printk_print, NULL);
+}
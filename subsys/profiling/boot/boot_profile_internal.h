@@ -0,0 +1,21 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_PROFILING_BOOT_BOOT_PROFILE_INTERNAL_H_
+#define ZEPHYR_SUBSYS_PROFILING_BOOT_BOOT_PROFILE_INTERNAL_H_
+
+#include <zephyr/profiling/boot_profile.h>
+
+/* Bumped when the columns of the CSV dump change */
+#define BOOT_PROFILE_DUMP_VERSION 1
+
+typedef void (*boot_profile_print_t)(void *ctx, const char *fmt, ...);
+
+const char *z_boot_profile_level_name(const struct boot_profile_record *record);
+
+void z_boot_profile_dump(boot_profile_print_t print, void *ctx);
+
+#endif /* ZEPHYR_SUBSYS_PROFILING_BOOT_BOOT_PROFILE_INTERNAL_H_ */
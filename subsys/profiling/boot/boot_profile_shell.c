@@ -0,0 +1,74 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "boot_profile_internal.h"
+
+static void shell_print_cb(void *ctx, const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	shell_vfprintf(ctx, SHELL_NORMAL, fmt, ap);
+	va_end(ap);
+}
+
+static int cmd_boot_profile_show(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct boot_profile_record *records;
+	size_t count = boot_profile_entries_get(&records);
+	uint64_t total_cycles = 0U;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-24s %10s", "Phase", "Time (us)");
+	for (int i = 0; i < BOOT_PROFILE_PHASE_COUNT; i++) {
+		const struct boot_profile_record *phase = boot_profile_phase_get(i);
+
+		shell_print(sh, "%-24s %10u", boot_profile_name(phase),
+			    k_cyc_to_us_floor32(phase->cycles));
+	}
+
+	shell_print(sh, "\n%-24s %-12s %5s %10s %10s %6s", "Init entry", "Level", "Prio",
+		    "Start (us)", "Time (us)", "Result");
+	for (size_t i = 0; i < count; i++) {
+		const struct boot_profile_record *record = &records[i];
+
+		shell_print(sh, "%-24s %-12s %5u %10llu %10u %6d", boot_profile_name(record),
+			    z_boot_profile_level_name(record), record->entry->priority,
+			    k_cyc_to_us_floor64(record->start),
+			    k_cyc_to_us_floor32(record->cycles), record->result);
+		total_cycles += record->cycles;
+	}
+
+	shell_print(sh, "\n%zu init entries, %llu us in total", count,
+		    k_cyc_to_us_floor64(total_cycles));
+
+	return 0;
+}
+
+static int cmd_boot_profile_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	z_boot_profile_dump(shell_print_cb, (void *)sh);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_boot_profile,
+	SHELL_CMD(show, NULL, "Show the boot profile", cmd_boot_profile_show),
+	SHELL_CMD(dump, NULL, "Dump the boot profile as CSV", cmd_boot_profile_dump),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(boot_profile, &sub_boot_profile, "Boot time profiling", NULL);
@@ -90,6 +90,13 @@ static int cmd_device_list(const struct shell *sh,
 			shell_fprintf(sh, SHELL_NORMAL, " (%s)\n", state);
 		}
 
+#ifdef CONFIG_DEVICE_INIT_STATS
+		if (!k_is_user_context() && dev->state->initialized) {
+			shell_fprintf(sh, SHELL_NORMAL, "  init time: %u us\n",
+				      device_init_time_us(dev));
+		}
+#endif /* CONFIG_DEVICE_INIT_STATS */
+
 #ifdef CONFIG_DEVICE_DEPS
 		if (!k_is_user_context()) {
 			struct cmd_device_list_visitor_context ctx = {
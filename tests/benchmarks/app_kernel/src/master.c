@@ -130,6 +130,11 @@ static void test_thread_entry(void *p1, void *p2, void *p3)
 	}
 
 	pipe_test();
+
+	/* Producer threads are created by the test thread */
+	if (!skip_mem_and_mbox) {
+		mpsc_test();
+	}
 }
 
 /**
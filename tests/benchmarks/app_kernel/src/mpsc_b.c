@@ -0,0 +1,124 @@
+/* mpsc_b.c */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+/*
+ * Multiple producers feeding a single consumer.  All producers share the
+ * priority of the consumer, so they fill the queue until it is full or
+ * until their share is sent, and the consumer then drains it.
+ */
+
+#define MPSC_MAX_PRODUCERS 4
+#define MPSC_STACK_SIZE    (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MPSC_MSGQ_LEN      64
+
+struct mpsc_item {
+	void *reserved;
+	uint32_t data;
+};
+
+K_MSGQ_DEFINE(MPSC_MSGQ, sizeof(uint32_t), MPSC_MSGQ_LEN, 4);
+K_FIFO_DEFINE(MPSC_FIFO);
+
+static struct k_thread producers[MPSC_MAX_PRODUCERS];
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, MPSC_MAX_PRODUCERS, MPSC_STACK_SIZE);
+
+static struct mpsc_item items[NR_OF_MPSC_RUNS];
+
+static void msgq_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t first = (uint32_t)(uintptr_t)p1;
+	uint32_t count = (uint32_t)(uintptr_t)p2;
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = first; i < first + count; i++) {
+		k_msgq_put(&MPSC_MSGQ, &i, K_FOREVER);
+	}
+}
+
+static void fifo_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t first = (uint32_t)(uintptr_t)p1;
+	uint32_t count = (uint32_t)(uintptr_t)p2;
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = first; i < first + count; i++) {
+		k_fifo_put(&MPSC_FIFO, &items[i]);
+	}
+}
+
+static void start_producers(k_thread_entry_t entry, unsigned int num_producers)
+{
+	int priority = k_thread_priority_get(k_current_get());
+	uint32_t share = NR_OF_MPSC_RUNS / num_producers;
+
+	for (unsigned int i = 0; i < num_producers; i++) {
+		k_thread_create(&producers[i], producer_stacks[i],
+				K_THREAD_STACK_SIZEOF(producer_stacks[i]), entry,
+				(void *)(uintptr_t)(i * share), (void *)(uintptr_t)share, NULL,
+				priority, 0, K_NO_WAIT);
+	}
+}
+
+static void join_producers(unsigned int num_producers)
+{
+	for (unsigned int i = 0; i < num_producers; i++) {
+		k_thread_join(&producers[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Multiple producer, single consumer throughput test
+ */
+void mpsc_test(void)
+{
+	uint64_t et; /* elapsed time */
+	uint32_t total;
+	uint32_t data;
+	timing_t start;
+	timing_t end;
+
+	PRINT_STRING(dashline);
+
+	for (unsigned int n = 1; n <= MPSC_MAX_PRODUCERS; n *= 2) {
+		total = (NR_OF_MPSC_RUNS / n) * n;
+
+		start = timing_timestamp_get();
+		start_producers(msgq_producer, n);
+		for (uint32_t i = 0; i < total; i++) {
+			k_msgq_get(&MPSC_MSGQ, &data, K_FOREVER);
+		}
+		end = timing_timestamp_get();
+		join_producers(n);
+		et = timing_cycles_get(&start, &end);
+
+		snprintf(msg, MAX_MSG, "put/get 4 bytes msg in MSGQ, %u producer%s",
+			 n, (n > 1) ? "s" : "");
+		PRINT_F(FORMAT, msg, timing_cycles_to_ns_avg(et, total));
+	}
+
+	for (unsigned int n = 1; n <= MPSC_MAX_PRODUCERS; n *= 2) {
+		total = (NR_OF_MPSC_RUNS / n) * n;
+
+		start = timing_timestamp_get();
+		start_producers(fifo_producer, n);
+		for (uint32_t i = 0; i < total; i++) {
+			(void)k_fifo_get(&MPSC_FIFO, K_FOREVER);
+		}
+		end = timing_timestamp_get();
+		join_producers(n);
+		et = timing_cycles_get(&start, &end);
+
+		snprintf(msg, MAX_MSG, "put/get item in FIFO, %u producer%s",
+			 n, (n > 1) ? "s" : "");
+		PRINT_F(FORMAT, msg, timing_cycles_to_ns_avg(et, total));
+	}
+}
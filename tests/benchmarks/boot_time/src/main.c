@@ -0,0 +1,52 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/lazy_bss.h>
+#include <zephyr/profiling/boot_profile.h>
+#include <zephyr/sys/printk.h>
+
+/* Stands for the network buffer pools, heaps and log buffers of an application */
+static uint8_t buffer[CONFIG_BENCHMARK_BSS_BUFFER_SIZE] __lazy_bss __aligned(4);
+
+static uint32_t phase_us(enum boot_profile_phase phase)
+{
+	return k_cyc_to_us_floor32(boot_profile_phase_get(phase)->cycles);
+}
+
+static bool buffer_is_zero(void)
+{
+	for (size_t i = 0; i < sizeof(buffer); i++) {
+		if (buffer[i] != 0U) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(void)
+{
+	uint32_t start;
+	uint32_t ensure_cycles;
+
+	/* Time the clearing the boot path no longer does with CONFIG_LAZY_BSS */
+	start = k_cycle_get_32();
+	lazy_bss_ensure(buffer, sizeof(buffer));
+	ensure_cycles = k_cycle_get_32() - start;
+
+	printk("bss_zero %7u us data_copy %7u us pre_kernel %7u us post_kernel %7u us\n",
+	       phase_us(BOOT_PROFILE_PHASE_BSS_ZERO), phase_us(BOOT_PROFILE_PHASE_DATA_COPY),
+	       phase_us(BOOT_PROFILE_PHASE_PRE_KERNEL), phase_us(BOOT_PROFILE_PHASE_POST_KERNEL));
+	printk("lazy_bss %7zu bytes ensure %7u us\n",
+	       IS_ENABLED(CONFIG_LAZY_BSS) ? sizeof(buffer) : (size_t)0,
+	       k_cyc_to_us_floor32(ensure_cycles));
+	printk("buffer %s\n", buffer_is_zero() ? "zeroed" : "NOT zeroed");
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -8,8 +8,9 @@
 /*
  * @file measure time for mutex lock and unlock
  *
- * This file contains the test that measures mutex lock and unlock times
- * in the kernel. There is no contention on the mutex being tested.
+ * This file contains the tests that measure mutex lock and unlock times
+ * in the kernel: without contention, and on SMP systems with two threads
+ * on different CPUs contending for the mutex.
  */
 
 #include <zephyr/kernel.h>
@@ -115,3 +116,88 @@ int mutex_lock_unlock(uint32_t num_iterations, uint32_t options)
 	timing_stop();
 	return 0;
 }
+
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+extern struct k_thread busy_thread[CONFIG_MP_MAX_NUM_CPUS - 1];
+
+static K_MUTEX_DEFINE(contended_mutex);
+
+/* Keeps the critical section from being optimized out */
+static volatile uint32_t contended_count;
+
+static void contended_lock_unlock(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		k_mutex_lock(&contended_mutex, K_FOREVER);
+		contended_count++;
+		k_mutex_unlock(&contended_mutex);
+	}
+}
+
+/**
+ *
+ * @brief Test for the mutex lock/unlock time under contention
+ *
+ * Two threads on different CPUs repeatedly lock the same mutex, bump a
+ * counter and unlock it.  One of the busy threads occupying the other
+ * CPUs is suspended for the duration of the test to make room for the
+ * second thread.  Build with and without CONFIG_MUTEX_ADAPTIVE_SPIN to
+ * compare spinning on the mutex with pending on it.
+ *
+ * @return 0 on success
+ */
+int mutex_lock_unlock_contended(uint32_t num_iterations)
+{
+	char description[120];
+	int  priority;
+	timing_t  start;
+	timing_t  finish;
+	uint64_t  cycles;
+
+	timing_start();
+
+	priority = k_thread_priority_get(k_current_get());
+	contended_count = 0;
+
+	k_thread_suspend(&busy_thread[0]);
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			contended_lock_unlock,
+			(void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority - 1, 0, K_FOREVER);
+	k_thread_create(&alt_thread, alt_stack,
+			K_THREAD_STACK_SIZEOF(alt_stack),
+			contended_lock_unlock,
+			(void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority - 1, 0, K_FOREVER);
+
+	start = timing_timestamp_get();
+
+	k_thread_start(&start_thread);
+	k_thread_start(&alt_thread);
+	k_thread_join(&start_thread, K_FOREVER);
+	k_thread_join(&alt_thread, K_FOREVER);
+
+	finish = timing_timestamp_get();
+
+	k_thread_resume(&busy_thread[0]);
+
+	cycles = timing_cycles_get(&start, &finish);
+
+	snprintf(description, sizeof(description),
+		 "%-40s - Lock+unlock a contended mutex (%s)",
+		 "mutex.lock_unlock.contended.kernel",
+		 IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "spin" : "pend");
+	PRINT_STATS_AVG(description, (uint32_t)cycles, 2 * num_iterations,
+			contended_count != 2 * num_iterations, "");
+
+	timing_stop();
+	return 0;
+}
+#endif /* CONFIG_MP_MAX_NUM_CPUS > 1 */
@@ -0,0 +1,205 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file measures the time net_conn_input() takes to find the connection
+ * of an incoming UDP packet, while a growing number of connected UDP sockets
+ * is registered. Packets are handed directly to net_conn_input(), so neither
+ * the L2 nor the IP layers contribute to these measurements.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include "connection.h"
+
+#define NUM_LOOKUPS	1000
+
+#define LOCAL_PORT	4242
+#define LISTEN_PORT	7
+#define REMOTE_PORT	10000
+
+static const uint16_t num_conns[] = { 8, 64, 256, 1024 };
+
+BUILD_ASSERT(CONFIG_NET_MAX_CONN >= 1024 + 1);
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+static struct net_if *bench_iface;
+static unsigned int received;
+static int result = TC_PASS;
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_conn_bench, "net_conn_bench", bench_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+static enum net_verdict bench_recv(struct net_conn *conn, struct net_pkt *pkt,
+				   union net_ip_header *ip_hdr,
+				   union net_proto_header *proto_hdr,
+				   void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* The packet is kept and fed again */
+	received++;
+
+	return NET_OK;
+}
+
+static void addr_set(struct net_sockaddr_in *addr, uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+{
+	addr->sin_family = NET_AF_INET;
+	addr->sin_addr.s4_addr[0] = a;
+	addr->sin_addr.s4_addr[1] = b;
+	addr->sin_addr.s4_addr[2] = c;
+	addr->sin_addr.s4_addr[3] = d;
+}
+
+static int conn_add(size_t idx, struct net_sockaddr_in *local, struct net_sockaddr_in *remote)
+{
+	return net_conn_register(NET_IPPROTO_UDP, NET_SOCK_DGRAM, NET_AF_INET,
+				 (struct net_sockaddr *)remote, (struct net_sockaddr *)local,
+				 REMOTE_PORT + idx, LOCAL_PORT, NULL, bench_recv, NULL,
+				 &handles[idx]);
+}
+
+static uint32_t lookup_time(struct net_pkt *pkt, struct net_ipv4_hdr *hdr,
+			    struct net_udp_hdr *udp)
+{
+	union net_ip_header ip_hdr = { .ipv4 = hdr };
+	union net_proto_header proto_hdr = { .udp = udp };
+	timing_t start, end;
+	uint64_t cycles;
+
+	received = 0;
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_LOOKUPS; i++) {
+		(void)net_conn_input(pkt, &ip_hdr, NET_IPPROTO_UDP, &proto_hdr);
+	}
+	end = timing_counter_get();
+
+	if (received != NUM_LOOKUPS) {
+		TC_ERROR("%u packets received out of %u\n", received, NUM_LOOKUPS);
+		result = TC_FAIL;
+	}
+
+	cycles = timing_cycles_get(&start, &end);
+
+	return (uint32_t)timing_cycles_to_ns_avg(cycles, NUM_LOOKUPS);
+}
+
+int main(void)
+{
+	struct net_sockaddr_in local = { 0 };
+	struct net_sockaddr_in remote = { 0 };
+	struct net_conn_handle *listener;
+	struct net_ipv4_hdr hdr = { 0 };
+	struct net_udp_hdr udp = { 0 };
+	struct net_pkt *pkt;
+	size_t registered = 0;
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	bench_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+
+	pkt = net_pkt_rx_alloc_on_iface(bench_iface, K_FOREVER);
+	net_pkt_set_family(pkt, NET_AF_INET);
+
+	addr_set(&local, 192, 0, 2, 1);
+	addr_set(&remote, 198, 51, 100, 1);
+	memcpy(hdr.dst, &local.sin_addr, sizeof(hdr.dst));
+	memcpy(hdr.src, &remote.sin_addr, sizeof(hdr.src));
+
+	ret = net_conn_register(NET_IPPROTO_UDP, NET_SOCK_DGRAM, NET_AF_INET, NULL, NULL,
+				0, LISTEN_PORT, NULL, bench_recv, NULL, &listener);
+	if (ret < 0) {
+		TC_ERROR("Cannot register listener (%d)\n", ret);
+		result = TC_FAIL;
+		goto out;
+	}
+
+	printk("Connection lookup, %u buckets, average of %u lookups\n",
+	       CONFIG_NET_CONN_HASH_BUCKETS, NUM_LOOKUPS);
+
+	for (size_t i = 0; i < ARRAY_SIZE(num_conns); i++) {
+		uint32_t connected_ns, listener_ns;
+
+		while (registered < num_conns[i]) {
+			ret = conn_add(registered, &local, &remote);
+			if (ret < 0) {
+				TC_ERROR("Cannot register connection %zu (%d)\n", registered, ret);
+				result = TC_FAIL;
+				goto out;
+			}
+
+			registered++;
+		}
+
+		/* First connection registered, last one found by linear lookups */
+		udp.src_port = net_htons(REMOTE_PORT);
+		udp.dst_port = net_htons(LOCAL_PORT);
+		connected_ns = lookup_time(pkt, &hdr, &udp);
+
+		udp.src_port = net_htons(REMOTE_PORT - 1);
+		udp.dst_port = net_htons(LISTEN_PORT);
+		listener_ns = lookup_time(pkt, &hdr, &udp);
+
+		printk("%4u connections: connected %6u ns, listener %6u ns\n",
+		       num_conns[i], connected_ns, listener_ns);
+	}
+
+	for (size_t i = 0; i < registered; i++) {
+		(void)net_conn_unregister(handles[i]);
+	}
+
+	(void)net_conn_unregister(listener);
+
+out:
+	net_pkt_unref(pkt);
+	timing_stop();
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
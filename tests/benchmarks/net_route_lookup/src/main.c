@@ -0,0 +1,194 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file measures the time net_route_lookup() takes to find the IPv6 route
+ * of a destination address, while a growing number of routes is installed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+#define NUM_LOOKUPS	1024
+#define NUM_NEXTHOPS	CONFIG_NET_IPV6_MAX_NEIGHBORS
+#define PREFIX_LEN	48
+
+static const uint16_t num_routes[] = { 8, 64, 256 };
+
+BUILD_ASSERT(CONFIG_NET_MAX_ROUTES >= 256);
+
+static struct net_in6_addr dsts[CONFIG_NET_MAX_ROUTES];
+static struct net_in6_addr nexthops[NUM_NEXTHOPS];
+static struct net_if *bench_iface;
+static int result = TC_PASS;
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench", bench_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+/* 2001:db8:<idx>::<host>, routes cover 2001:db8:<idx>::/48 */
+static void addr_set(struct net_in6_addr *addr, uint16_t idx, uint16_t host)
+{
+	*addr = (struct net_in6_addr){ 0 };
+	addr->s6_addr16[0] = net_htons(0x2001);
+	addr->s6_addr16[1] = net_htons(0x0db8);
+	addr->s6_addr16[2] = net_htons(idx);
+	addr->s6_addr16[7] = net_htons(host);
+}
+
+static int nexthops_add(void)
+{
+	struct net_linkaddr lladdr;
+	uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x00 };
+
+	for (int i = 0; i < NUM_NEXTHOPS; i++) {
+		nexthops[i] = (struct net_in6_addr){ 0 };
+		nexthops[i].s6_addr16[0] = net_htons(0xfe80);
+		nexthops[i].s6_addr16[7] = net_htons(i + 2);
+
+		mac[5] = i + 2;
+		(void)net_linkaddr_set(&lladdr, mac, sizeof(mac));
+		lladdr.type = NET_LINK_ETHERNET;
+
+		if (net_ipv6_nbr_add(bench_iface, &nexthops[i], &lladdr, true,
+				     NET_IPV6_NBR_STATE_REACHABLE) == NULL) {
+			TC_ERROR("Cannot add neighbor %d\n", i);
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static int route_add(uint16_t idx)
+{
+	struct net_in6_addr prefix;
+
+	addr_set(&prefix, idx, 0);
+	addr_set(&dsts[idx], idx, 1);
+
+	if (net_route_add(bench_iface, &prefix, PREFIX_LEN, &nexthops[idx % NUM_NEXTHOPS],
+			  NET_IPV6_ND_INFINITE_LIFETIME, NET_ROUTE_PREFERENCE_MEDIUM) == NULL) {
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+/* Look up dst[0], dst[1]... dst[num - 1] in turn, whose routes must be found or not */
+static uint32_t lookup_time(struct net_in6_addr *dst, size_t num, bool found)
+{
+	struct net_route_entry *route;
+	unsigned int misses = 0;
+	timing_t start, end;
+	uint64_t cycles;
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_LOOKUPS; i++) {
+		route = net_route_lookup(bench_iface, &dst[i % num]);
+		if ((route != NULL) != found) {
+			misses++;
+		}
+	}
+	end = timing_counter_get();
+
+	if (misses != 0) {
+		TC_ERROR("%u unexpected lookup results out of %u\n", misses, NUM_LOOKUPS);
+		result = TC_FAIL;
+	}
+
+	cycles = timing_cycles_get(&start, &end);
+
+	return (uint32_t)timing_cycles_to_ns_avg(cycles, NUM_LOOKUPS);
+}
+
+int main(void)
+{
+	struct net_in6_addr unrouted;
+	size_t installed = 0;
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	bench_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+
+	ret = nexthops_add();
+	if (ret < 0) {
+		result = TC_FAIL;
+		goto out;
+	}
+
+	addr_set(&unrouted, 0xffff, 1);
+	unrouted.s6_addr16[1] = net_htons(0x0db9);
+
+	printk("Route lookup, %s, %u cache entries, average of %u lookups\n",
+	       IS_ENABLED(CONFIG_NET_ROUTE_LPM_TRIE) ? "trie" : "linear",
+	       CONFIG_NET_ROUTE_CACHE_SIZE, NUM_LOOKUPS);
+
+	for (size_t i = 0; i < ARRAY_SIZE(num_routes); i++) {
+		uint32_t spread_ns, single_ns, miss_ns;
+
+		while (installed < num_routes[i]) {
+			ret = route_add(installed);
+			if (ret < 0) {
+				TC_ERROR("Cannot add route %zu (%d)\n", installed, ret);
+				result = TC_FAIL;
+				goto out;
+			}
+
+			installed++;
+		}
+
+		spread_ns = lookup_time(dsts, installed, true);
+		single_ns = lookup_time(&dsts[0], 1, true);
+		miss_ns = lookup_time(&unrouted, 1, false);
+
+		printk("%4u routes: spread %6u ns, single %6u ns, miss %6u ns\n",
+		       num_routes[i], spread_ns, single_ns, miss_ns);
+	}
+
+out:
+	timing_stop();
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the time from giving a semaphore to the wake up of a thread
+ * polling it among a growing number of events.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define WAITER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* The waiter preempts the main thread as soon as one of its events fires */
+#define MAIN_PRIO   K_PRIO_PREEMPT(10)
+#define WAITER_PRIO K_PRIO_PREEMPT(1)
+
+enum wait_mode {
+	WAIT_POLL,
+	WAIT_SET_LEVEL,
+	WAIT_SET_EDGE,
+};
+
+static const char *const mode_tags[] = {
+	[WAIT_POLL] = "k_poll",
+	[WAIT_SET_LEVEL] = "poll_set.level",
+	[WAIT_SET_EDGE] = "poll_set.edge",
+};
+
+static struct k_sem sems[CONFIG_BENCHMARK_MAX_EVENTS];
+static struct k_poll_event events[CONFIG_BENCHMARK_MAX_EVENTS];
+static struct k_poll_set set;
+
+static K_THREAD_STACK_DEFINE(waiter_stack, WAITER_STACK_SIZE);
+static struct k_thread waiter_thread;
+
+static timing_t wake_time;
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	enum wait_mode mode = POINTER_TO_UINT(p1);
+	int num_events = POINTER_TO_INT(p2);
+	struct k_poll_event *ready;
+
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		if (mode == WAIT_POLL) {
+			for (int j = 0; j < num_events; j++) {
+				events[j].state = K_POLL_STATE_NOT_READY;
+			}
+			(void)k_poll(events, num_events, K_FOREVER);
+		} else {
+			(void)k_poll_set_wait(&set, &ready, 1, K_FOREVER);
+		}
+
+		wake_time = timing_counter_get();
+
+		(void)k_sem_take(&sems[num_events - 1], K_NO_WAIT);
+	}
+}
+
+static void report(enum wait_mode mode, int num_events, uint64_t minimum, uint64_t maximum,
+		   uint64_t total)
+{
+	uint64_t average = total / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: poll.%s.%03d.events.min - Wake up, minimum : %7llu cycles , %7u ns :\n",
+	       mode_tags[mode], num_events, minimum, (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: poll.%s.%03d.events.max - Wake up, maximum : %7llu cycles , %7u ns :\n",
+	       mode_tags[mode], num_events, maximum, (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: poll.%s.%03d.events.avg - Wake up, average : %7llu cycles , %7u ns :\n",
+	       mode_tags[mode], num_events, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("%-16s %3d events: min %7llu max %7llu avg %7llu cycles (avg %7u nsec)\n",
+	       mode_tags[mode], num_events, minimum, maximum, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_wake_up(enum wait_mode mode, int num_events)
+{
+	uint64_t minimum = UINT64_MAX;
+	uint64_t maximum = 0U;
+	uint64_t total = 0U;
+	timing_t start;
+	uint64_t cycles;
+
+	for (int i = 0; i < num_events; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  (mode == WAIT_SET_EDGE) ? K_POLL_MODE_EDGE_TRIGGERED
+							  : K_POLL_MODE_NOTIFY_ONLY,
+				  &sems[i]);
+	}
+
+	if (mode != WAIT_POLL) {
+		k_poll_set_init(&set);
+		for (int i = 0; i < num_events; i++) {
+			k_poll_set_add(&set, &events[i]);
+		}
+	}
+
+	k_thread_create(&waiter_thread, waiter_stack, K_THREAD_STACK_SIZEOF(waiter_stack),
+			waiter_entry, UINT_TO_POINTER(mode), INT_TO_POINTER(num_events), NULL,
+			WAITER_PRIO, 0, K_NO_WAIT);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		/* The waiter runs until it waits again before this returns */
+		start = timing_counter_get();
+		k_sem_give(&sems[num_events - 1]);
+		cycles = timing_cycles_get(&start, &wake_time);
+
+		minimum = MIN(minimum, cycles);
+		maximum = MAX(maximum, cycles);
+		total += cycles;
+	}
+
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	if (mode != WAIT_POLL) {
+		for (int i = 0; i < num_events; i++) {
+			k_poll_set_remove(&set, &events[i]);
+		}
+	}
+
+	report(mode, num_events, minimum, maximum, total);
+}
+
+int main(void)
+{
+	timing_init();
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	printk("Time Measurements for poll wake ups\n");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (int mode = WAIT_POLL; mode <= WAIT_SET_EDGE; mode++) {
+		for (int num_events = 1; num_events <= CONFIG_BENCHMARK_MAX_EVENTS;
+		     num_events *= 2) {
+			test_wake_up(mode, num_events);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -240,7 +240,8 @@ int main(void)
 
 	printk("Time Measurements for %s sched queues\n",
 	       IS_ENABLED(CONFIG_SCHED_SIMPLE) ? "simple" :
-	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq");
+	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" :
+	       IS_ENABLED(CONFIG_SCHED_MULTIQ) ? "multiq" : "bitmap");
 	printk("Timing results: Clock frequency: %u MHz\n", freq);
 
 	start_threads(CONFIG_BENCHMARK_NUM_THREADS);
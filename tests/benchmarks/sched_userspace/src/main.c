@@ -69,6 +69,143 @@ void yielder_entry(void *_thread, void *_tid, void *_nb_threads)
 
 static k_tid_t threads[MAX_NB_THREADS];
 
+K_APPMEM_PARTITION_DEFINE(mutex_partition);
+K_APP_DMEM(mutex_partition) struct mutex_bench mutex_bench;
+K_MUTEX_DEFINE(bench_kmutex);
+
+static k_thread_entry_t mutex_fn;
+
+void mutex_entry(void *_thread, void *p2, void *p3)
+{
+	struct k_app_thread *thread = (struct k_app_thread *) _thread;
+	int ret;
+
+	struct k_mem_partition *parts[] = {
+		thread->partition,
+		&mutex_partition,
+	};
+
+	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	if (ret != 0) {
+		printk("k_mem_domain_init failed %d\n", ret);
+		yielder_status = 1;
+		return;
+	}
+
+	k_mem_domain_add_thread(&thread->domain, k_current_get());
+
+	k_thread_user_mode_enter(mutex_fn, &mutex_bench, NULL, NULL);
+}
+
+static int exec_mutex_test(const char *name, k_thread_entry_t fn,
+			   uint8_t nb_threads)
+{
+	yielder_status = 0;
+	mutex_fn = fn;
+	mutex_bench.kmutex = &bench_kmutex;
+	mutex_bench.rounds = NB_LOCKS / nb_threads;
+	mutex_bench.kernel_calls = 0;
+
+	for (size_t tid = 0; tid < nb_threads; tid++) {
+		app_threads[tid].partition = app_partitions[tid];
+		app_threads[tid].stack = &app_thread_stacks[tid];
+
+		threads[tid] = k_thread_create(&app_threads[tid].thread,
+					app_thread_stacks[tid],
+					APP_STACKSIZE, mutex_entry,
+					&app_threads[tid], NULL, NULL,
+					THREADS_PRIO, 0, K_FOREVER);
+		k_object_access_grant(&bench_kmutex, threads[tid]);
+	}
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	stamp(MEAS_START);
+	for (size_t tid = 0; tid < nb_threads; tid++) {
+		k_thread_start(threads[tid]);
+	}
+	for (size_t tid = 0; tid < nb_threads; tid++) {
+		k_thread_join(threads[tid], K_FOREVER);
+	}
+	stamp(MEAS_END);
+
+	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	uint32_t pairs = mutex_bench.rounds * nb_threads;
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time) / pairs;
+
+	printk("%-26s %2u threads: %8" PRIu32 " cyc & %6" PRIu32 " pairs -> %6"
+	       PRIu64 " ns & %" PRIu32 ".%02" PRIu32 " syscalls per pair\n",
+	       name, nb_threads, full_time, pairs, time_ns,
+	       mutex_bench.kernel_calls / pairs,
+	       (uint32_t)((100ULL * (mutex_bench.kernel_calls % pairs)) / pairs));
+
+	return yielder_status;
+}
+
+K_APPMEM_PARTITION_DEFINE(batch_partition);
+K_APP_DMEM(batch_partition) struct batch_bench batch_bench;
+K_SEM_DEFINE(bench_ksem, 0, 1);
+
+static k_thread_entry_t batch_fn;
+
+void batch_entry(void *_thread, void *p2, void *p3)
+{
+	struct k_app_thread *thread = (struct k_app_thread *) _thread;
+	int ret;
+
+	struct k_mem_partition *parts[] = {
+		thread->partition,
+		&batch_partition,
+	};
+
+	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	if (ret != 0) {
+		printk("k_mem_domain_init failed %d\n", ret);
+		yielder_status = 1;
+		return;
+	}
+
+	k_mem_domain_add_thread(&thread->domain, k_current_get());
+
+	k_thread_user_mode_enter(batch_fn, &batch_bench, NULL, NULL);
+}
+
+static int exec_batch_test(const char *name, k_thread_entry_t fn)
+{
+	yielder_status = 0;
+	batch_fn = fn;
+	batch_bench.ksem = &bench_ksem;
+	batch_bench.rounds = NB_SEM_OPS / BATCH_SIZE;
+	batch_bench.kernel_calls = 0;
+
+	app_threads[0].partition = app_partitions[0];
+	app_threads[0].stack = &app_thread_stacks[0];
+
+	threads[0] = k_thread_create(&app_threads[0].thread, app_thread_stacks[0],
+				     APP_STACKSIZE, batch_entry, &app_threads[0], NULL, NULL,
+				     THREADS_PRIO, 0, K_FOREVER);
+	k_object_access_grant(&bench_ksem, threads[0]);
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	stamp(MEAS_START);
+	k_thread_start(threads[0]);
+	k_thread_join(threads[0], K_FOREVER);
+	stamp(MEAS_END);
+
+	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	uint32_t ops = batch_bench.rounds * BATCH_SIZE;
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time) / ops;
+
+	printk("%-26s: %8" PRIu32 " cyc & %6" PRIu32 " ops -> %6" PRIu64
+	       " ns & %" PRIu32 ".%02" PRIu32 " syscalls per op\n",
+	       name, full_time, ops, time_ns,
+	       batch_bench.kernel_calls / ops,
+	       (uint32_t)((100ULL * (batch_bench.kernel_calls % ops)) / ops));
+
+	return yielder_status;
+}
+
 static int exec_test(uint8_t nb_threads)
 {
 	if (nb_threads > MAX_NB_THREADS) {
@@ -136,6 +273,29 @@ int main(void)
 		}
 	}
 
+	printk("============================\n");
+	printk("user mode mutexes (%s)\n",
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FAST) ? "futex fast path" : "syscalls");
+
+	ret = exec_mutex_test("k_mutex", k_mutex_loop, 1);
+	ret = ret ? ret : exec_mutex_test("sys_mutex", sys_mutex_loop, 1);
+	ret = ret ? ret : exec_mutex_test("sys_mutex", sys_mutex_loop, 2);
+	ret = ret ? ret : exec_mutex_test("sys_mutex (handoff)", sys_mutex_yield_loop, 2);
+	if (ret != 0) {
+		printk("FAIL\n");
+		return 0;
+	}
+
+	printk("============================\n");
+	printk("user mode semaphore give/take (%u per batch)\n", BATCH_SIZE);
+
+	ret = exec_batch_test("syscalls", sem_loop);
+	ret = ret ? ret : exec_batch_test("k_syscall_batch", sem_batch_loop);
+	if (ret != 0) {
+		printk("FAIL\n");
+		return 0;
+	}
+
 	printk("SUCCESS\n");
 	return 0;
 }
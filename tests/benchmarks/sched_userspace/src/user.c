@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <zephyr/kernel.h>
+#include <zephyr/kernel/syscall_batch.h>
 
 #include "user.h"
 
@@ -19,3 +20,101 @@ void context_switch_yield(void *p1, void *p2, void *p3)
 		k_yield();
 	}
 }
+
+/* Counts the calls which can't take the atomic fast path, that is
+ * which make a syscall.  Exact as long as the mutex isn't contended,
+ * a close estimate otherwise.
+ */
+static inline void bench_lock(struct mutex_bench *b)
+{
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (atomic_get(&b->mutex.val) != 0) {
+		b->kernel_calls++;
+	}
+#else
+	b->kernel_calls++;
+#endif
+	(void)sys_mutex_lock(&b->mutex, K_FOREVER);
+}
+
+static inline void bench_unlock(struct mutex_bench *b)
+{
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if ((atomic_get(&b->mutex.val) & SYS_MUTEX_WAITERS) != 0) {
+		b->kernel_calls++;
+	}
+#else
+	b->kernel_calls++;
+#endif
+	(void)sys_mutex_unlock(&b->mutex);
+}
+
+void sys_mutex_loop(void *p1, void *p2, void *p3)
+{
+	struct mutex_bench *b = p1;
+
+	for (uint32_t i = 0; i < b->rounds; i++) {
+		bench_lock(b);
+		bench_unlock(b);
+	}
+}
+
+/* Yield while holding the mutex, so that every lock by the other
+ * thread blocks and every unlock hands the mutex over.
+ */
+void sys_mutex_yield_loop(void *p1, void *p2, void *p3)
+{
+	struct mutex_bench *b = p1;
+
+	for (uint32_t i = 0; i < b->rounds; i++) {
+		bench_lock(b);
+		k_yield();
+		bench_unlock(b);
+	}
+}
+
+void k_mutex_loop(void *p1, void *p2, void *p3)
+{
+	struct mutex_bench *b = p1;
+
+	for (uint32_t i = 0; i < b->rounds; i++) {
+		(void)k_mutex_lock(b->kmutex, K_FOREVER);
+		(void)k_mutex_unlock(b->kmutex);
+		b->kernel_calls += 2U;
+	}
+}
+
+/* Gives and takes back a semaphore, BATCH_SIZE operations per round */
+void sem_loop(void *p1, void *p2, void *p3)
+{
+	struct batch_bench *b = p1;
+
+	for (uint32_t i = 0; i < b->rounds; i++) {
+		for (uint32_t j = 0; j < BATCH_SIZE / 2; j++) {
+			k_sem_give(b->ksem);
+			(void)k_sem_take(b->ksem, K_NO_WAIT);
+		}
+		b->kernel_calls += BATCH_SIZE;
+	}
+}
+
+/* Same operations as sem_loop(), one k_syscall_batch() call per round */
+void sem_batch_loop(void *p1, void *p2, void *p3)
+{
+	struct batch_bench *b = p1;
+	struct k_syscall_batch_entry entries[BATCH_SIZE];
+
+	for (uint32_t j = 0; j < BATCH_SIZE; j++) {
+		entries[j] = (struct k_syscall_batch_entry){
+			.op = ((j % 2U) == 0U) ? K_SYSCALL_BATCH_SEM_GIVE :
+						 K_SYSCALL_BATCH_SEM_TAKE,
+			.obj = b->ksem,
+			.timeout = K_NO_WAIT,
+		};
+	}
+
+	for (uint32_t i = 0; i < b->rounds; i++) {
+		(void)k_syscall_batch(entries, BATCH_SIZE);
+		b->kernel_calls++;
+	}
+}
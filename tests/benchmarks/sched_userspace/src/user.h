@@ -4,6 +4,35 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mutex.h>
+
 #define NB_YIELDS UINT32_C(1000000)
+#define NB_LOCKS UINT32_C(100000)
+#define NB_SEM_OPS UINT32_C(100000)
+
+/* Semaphore operations per k_syscall_batch() call */
+#define BATCH_SIZE 8
+
+/* Shared between the mutex benchmark threads, in mutex_partition */
+struct mutex_bench {
+	struct sys_mutex mutex;
+	struct k_mutex *kmutex;
+	uint32_t rounds;
+	/* Lock/unlock calls that could not complete in userspace */
+	uint32_t kernel_calls;
+};
+
+/* Used by the batched syscall benchmark thread, in batch_partition */
+struct batch_bench {
+	struct k_sem *ksem;
+	uint32_t rounds;
+	uint32_t kernel_calls;
+};
 
 void context_switch_yield(void *p1, void *p2, void *p3);
+void sys_mutex_loop(void *p1, void *p2, void *p3);
+void sys_mutex_yield_loop(void *p1, void *p2, void *p3);
+void k_mutex_loop(void *p1, void *p2, void *p3);
+void sem_loop(void *p1, void *p2, void *p3);
+void sem_batch_loop(void *p1, void *p2, void *p3);
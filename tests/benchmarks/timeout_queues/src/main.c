@@ -0,0 +1,282 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the time required to arm, abort and
+ * expire kernel timeouts while a varying number of other timeouts is armed.
+ * The timeouts are driven directly through the kernel timeout queue, and the
+ * ticks are announced by the test itself, so neither the scheduler nor the
+ * system timer driver contributes to these measurements. With
+ * CONFIG_SYS_CLOCK_TICKS_PER_SEC set to 1 the system timer barely interferes
+ * with the ticks announced by the test.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include "utils.h"
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+#include <stdio.h>
+
+/* Armed timeouts expire between BENCHMARK_MIN_DELTA and
+ * BENCHMARK_MIN_DELTA + BENCHMARK_DELTA_RANGE ticks from now. The minimum
+ * is larger than the number of ticks announced per iteration, so only the
+ * timeout armed for that purpose ever expires.
+ */
+#define BENCHMARK_MIN_DELTA   (2 * CONFIG_BENCHMARK_NUM_TIMEOUTS)
+#define BENCHMARK_DELTA_RANGE (1 << 20)
+
+static struct _timeout timeouts[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+static k_ticks_t deltas[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+static struct _timeout expiring_timeout;
+static unsigned int expirations;
+
+uint64_t add_cycles[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+uint64_t abort_cycles[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+uint64_t announce_cycles[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+
+static void armed_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	/* Never expected to expire */
+	TC_ERROR("Unexpected expiry of armed timeout\n");
+}
+
+static void expiring_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	expirations++;
+}
+
+/**
+ * Pick pseudo-random, but reproducible, expiries for each timeout.
+ */
+static void timeouts_init(unsigned int num_timeouts)
+{
+	uint32_t state = 0x2545f491;
+	unsigned int i;
+
+	z_init_timeout(&expiring_timeout);
+
+	for (i = 0; i < num_timeouts; i++) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		z_init_timeout(&timeouts[i]);
+		deltas[i] = BENCHMARK_MIN_DELTA + (state % BENCHMARK_DELTA_RANGE);
+	}
+}
+
+static void cycles_reset(unsigned int num_timeouts)
+{
+	unsigned int i;
+
+	for (i = 0; i < num_timeouts; i++) {
+		add_cycles[i] = 0ULL;
+		abort_cycles[i] = 0ULL;
+		announce_cycles[i] = 0ULL;
+	}
+}
+
+/**
+ * Arm the timeouts one after the other. After each one, arm one more timeout
+ * that expires on the next tick and announce that tick. Finally abort the
+ * armed timeouts, most recently armed first.
+ */
+static void test_timeout_queue(unsigned int num_timeouts)
+{
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+
+	for (i = 0; i < num_timeouts; i++) {
+		start = timing_counter_get();
+		z_add_timeout(&timeouts[i], armed_handler, K_TICKS(deltas[i]));
+		finish = timing_counter_get();
+
+		add_cycles[i] += timing_cycles_get(&start, &finish);
+
+		z_add_timeout(&expiring_timeout, expiring_handler, K_NO_WAIT);
+
+		start = timing_counter_get();
+		sys_clock_announce(1);
+		finish = timing_counter_get();
+
+		announce_cycles[i] += timing_cycles_get(&start, &finish);
+
+		/* In case a real tick elapsed while arming it */
+		(void)z_abort_timeout(&expiring_timeout);
+	}
+
+	for (i = num_timeouts; i > 0; i--) {
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[i - 1]);
+		finish = timing_counter_get();
+
+		abort_cycles[i - 1] += timing_cycles_get(&start, &finish);
+	}
+}
+
+static uint64_t sqrt_u64(uint64_t square)
+{
+	if (square > 1) {
+		uint64_t lo = sqrt_u64(square >> 2) << 1;
+		uint64_t hi = lo + 1;
+
+		return ((hi * hi) > square) ? lo : hi;
+	}
+
+	return square;
+}
+
+static void compute_and_report_stats(unsigned int num_timeouts, unsigned int num_iterations,
+				     uint64_t *cycles, const char *tag, const char *str)
+{
+	uint64_t minimum = cycles[0];
+	uint64_t maximum = cycles[0];
+	uint64_t total = cycles[0];
+	uint64_t average;
+	uint64_t std_dev = 0;
+	uint64_t tmp;
+	uint64_t diff;
+	unsigned int i;
+
+	for (i = 1; i < num_timeouts; i++) {
+		if (cycles[i] > maximum) {
+			maximum = cycles[i];
+		}
+
+		if (cycles[i] < minimum) {
+			minimum = cycles[i];
+		}
+
+		total += cycles[i];
+	}
+
+	minimum /= (uint64_t)num_iterations;
+	maximum /= (uint64_t)num_iterations;
+	average = total / (num_timeouts * num_iterations);
+
+	/* Calculate standard deviation */
+
+	for (i = 0; i < num_timeouts; i++) {
+		tmp = cycles[i] / num_iterations;
+		diff = (average > tmp) ? (average - tmp) : (tmp - average);
+
+		std_dev += (diff * diff);
+	}
+	std_dev /= num_timeouts;
+	std_dev = sqrt_u64(std_dev);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	int tag_len = strlen(tag);
+	int descr_len = strlen(str);
+	int stag_len = strlen(".stddev");
+	int sdescr_len = strlen(", stddev.");
+
+	stag_len = (tag_len + stag_len < 40) ? 40 - tag_len : stag_len;
+	sdescr_len = (descr_len + sdescr_len < 50) ? 50 - descr_len : sdescr_len;
+
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".min", str,
+	       sdescr_len, ", min.", minimum, (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".max", str,
+	       sdescr_len, ", max.", maximum, (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".avg", str,
+	       sdescr_len, ", avg.", average, (uint32_t)timing_cycles_to_ns(average));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".stddev", str,
+	       sdescr_len, ", stddev.", std_dev, (uint32_t)timing_cycles_to_ns(std_dev));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s\n", str);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+	printk("    Std Deviation: %7llu cycles (%7u nsec)\n", std_dev,
+	       (uint32_t)timing_cycles_to_ns(std_dev));
+#endif
+}
+
+#ifdef CONFIG_BENCHMARK_VERBOSE
+static void report_verbose(uint64_t *cycles, const char *op, unsigned int offset)
+{
+	char description[120];
+	char tag[50];
+	unsigned int i;
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_TIMEOUTS; i++) {
+		snprintf(tag, sizeof(tag), "TimeoutQ.%s.%05u.armed", op, i + offset);
+		snprintf(description, sizeof(description), "%-40s - %s with %u armed",
+			 tag, op, i + offset);
+		PRINT_STATS_AVG(description, (uint32_t)cycles[i],
+				CONFIG_BENCHMARK_NUM_ITERATIONS);
+	}
+}
+#endif
+
+int main(void)
+{
+	unsigned int i;
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timing wheel" : "simple");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	timeouts_init(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+
+	timing_start();
+
+	cycles_reset(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		test_timeout_queue(CONFIG_BENCHMARK_NUM_TIMEOUTS);
+	}
+
+	timing_stop();
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 add_cycles, "timeout.add", "Arm a timeout");
+#ifdef CONFIG_BENCHMARK_VERBOSE
+	report_verbose(add_cycles, "add", 0);
+#endif
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 abort_cycles, "timeout.abort", "Abort a timeout");
+#ifdef CONFIG_BENCHMARK_VERBOSE
+	report_verbose(abort_cycles, "abort", 1);
+#endif
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 announce_cycles, "timeout.announce",
+				 "Announce a tick expiring one timeout");
+#ifdef CONFIG_BENCHMARK_VERBOSE
+	report_verbose(announce_cycles, "announce", 2);
+#endif
+
+	printk("Timeouts expired: %u\n", expirations);
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define DT_DRV_COMPAT test_parallel_init
+
+struct parallel_init_config {
+	uint32_t delay_ms;
+};
+
+struct parallel_init_data {
+	int64_t start;
+	int64_t end;
+};
+
+static const struct device *const dev_a = DEVICE_DT_GET(DT_NODELABEL(parallel_a));
+static const struct device *const dev_b = DEVICE_DT_GET(DT_NODELABEL(parallel_b));
+static const struct device *const dev_c = DEVICE_DT_GET(DT_NODELABEL(parallel_c));
+
+static bool barrier_ok;
+
+static int parallel_init(const struct device *dev)
+{
+	const struct parallel_init_config *config = dev->config;
+	struct parallel_init_data *data = dev->data;
+
+	data->start = k_uptime_get();
+	k_msleep(config->delay_ms);
+	data->end = k_uptime_get();
+
+	return 0;
+}
+
+#define PARALLEL_INIT_DEFINE(inst)                                                          \
+	static const struct parallel_init_config config_##inst = {                          \
+		.delay_ms = DT_INST_PROP(inst, init_delay_ms),                               \
+	};                                                                                   \
+	static struct parallel_init_data data_##inst;                                        \
+	DEVICE_DT_INST_DEFINE(inst, parallel_init, NULL, &data_##inst, &config_##inst,       \
+			      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(PARALLEL_INIT_DEFINE)
+
+static int barrier_init(void)
+{
+	barrier_ok = device_is_ready(dev_a) && device_is_ready(dev_b) && device_is_ready(dev_c);
+
+	return 0;
+}
+
+SYS_INIT(barrier_init, POST_KERNEL, 99);
+
+static const struct parallel_init_data *get_data(const struct device *dev)
+{
+	return dev->data;
+}
+
+/**
+ * @brief Test that independent devices are initialized concurrently
+ */
+ZTEST(device_init_parallel, test_independent_overlap)
+{
+	const struct parallel_init_data *a = get_data(dev_a);
+	const struct parallel_init_data *b = get_data(dev_b);
+
+	zassert_true(device_is_ready(dev_a));
+	zassert_true(device_is_ready(dev_b));
+	zassert_true((a->start < b->end) && (b->start < a->end),
+		     "initializations of a [%lld, %lld] and b [%lld, %lld] do not overlap",
+		     a->start, a->end, b->start, b->end);
+}
+
+/**
+ * @brief Test that a device is initialized after the devices it requires
+ */
+ZTEST(device_init_parallel, test_dependency_order)
+{
+	const struct parallel_init_data *a = get_data(dev_a);
+	const struct parallel_init_data *c = get_data(dev_c);
+
+	zassert_true(device_is_ready(dev_c));
+	zassert_true(c->start >= a->end, "c started at %lld before a completed at %lld",
+		     c->start, a->end);
+}
+
+/**
+ * @brief Test that SYS_INIT functions run after the devices preceding them
+ */
+ZTEST(device_init_parallel, test_sys_init_barrier)
+{
+	zassert_true(barrier_ok, "SYS_INIT ran before the devices of its level completed");
+}
+
+/**
+ * @brief Test that the initialization time of devices is recorded
+ */
+ZTEST(device_init_parallel, test_init_time)
+{
+	zassert_true(device_init_time_us(dev_a) >= 100 * USEC_PER_MSEC,
+		     "unexpected init time %u us", device_init_time_us(dev_a));
+	zassert_true(device_init_time_us(dev_c) >= 20 * USEC_PER_MSEC,
+		     "unexpected init time %u us", device_init_time_us(dev_c));
+}
+
+ZTEST_SUITE(device_init_parallel, NULL, NULL, NULL, NULL, NULL);
@@ -105,6 +105,7 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 #ifndef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	printk("    - in ISR: %lu\n", stats->pagefaults.in_isr);
 #endif
+	printk("    - Prefetched pages: %lu\n", stats->pagefaults.prefetched);
 
 	printk("* Eviction (%s):\n", scope);
 	printk("    - Total pages evicted: %lu\n",
@@ -113,6 +114,14 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 	       stats->eviction.clean);
 	printk("    - Dirty pages evicted: %lu\n",
 	       stats->eviction.dirty);
+
+#ifdef CONFIG_DEMAND_PAGING_REFAULT_STATS
+	printk("* Refaults (%s):\n", scope);
+	printk("    - Total: %lu\n", stats->refaults.cnt);
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_REFAULT_HISTOGRAM_NUM_BINS; i++) {
+		printk("    - Distance bin %d: %lu\n", i, stats->refaults.distance[i]);
+	}
+#endif /* CONFIG_DEMAND_PAGING_REFAULT_STATS */
 }
 
 static void touch_anon_pages(bool zig, bool zag)
@@ -167,6 +176,9 @@ static void touch_anon_pages(bool zig, bool zag)
 #ifdef CONFIG_EVICTION_NRU
 	k_msleep(CONFIG_EVICTION_NRU_PERIOD * 2);
 #endif /* CONFIG_EVICTION_NRU */
+#ifdef CONFIG_EVICTION_CLOCK_PRO
+	k_msleep(CONFIG_EVICTION_CLOCK_PRO_PERIOD * 2);
+#endif /* CONFIG_EVICTION_CLOCK_PRO */
 
 	/* There should be some clean pages to be evicted now,
 	 * since the arena is not modified.
@@ -235,6 +247,7 @@ ZTEST(demand_paging, test_unmap_anon_pages)
 static void test_k_mem_page_out(void)
 {
 	unsigned long faults;
+	struct k_mem_paging_stats_t stats;
 	int key, ret;
 
 	/* Lock IRQs to prevent other pagefaults from happening while we
@@ -245,6 +258,17 @@ static void test_k_mem_page_out(void)
 	ret = k_mem_page_out(arena, HALF_BYTES);
 	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
 
+#ifdef CONFIG_BACKING_STORE_COMPRESSED_RAM
+	struct k_mem_paging_backing_store_stats_t bs_stats;
+
+	/* The arena holds zeroes or a repeated pattern, it must compress */
+	k_mem_paging_backing_store_stats_get(&bs_stats);
+	zassert_true(bs_stats.pages >= HALF_PAGES, "only %lu pages stored", bs_stats.pages);
+	zassert_true(bs_stats.stored_bytes < bs_stats.orig_bytes,
+		     "%zu bytes stored for %zu bytes paged out", bs_stats.stored_bytes,
+		     bs_stats.orig_bytes);
+#endif /* CONFIG_BACKING_STORE_COMPRESSED_RAM */
+
 	/* Write to the supposedly evicted region */
 	for (size_t i = 0; i < HALF_BYTES; i++) {
 		arena[i] = nums[i % 10];
@@ -252,9 +276,27 @@ static void test_k_mem_page_out(void)
 	faults = k_mem_num_pagefaults_get() - faults;
 	irq_unlock(key);
 
+#if CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0
+	/* Sequential writes fault on the first page of each prefetched group */
+	zassert_true((faults > 0) && (faults < HALF_PAGES),
+		     "unexpected num pagefaults expected less than %d got %lu",
+		     HALF_PAGES, faults);
+#else
 	zassert_equal(faults, HALF_PAGES,
 		      "unexpected num pagefaults expected %d got %lu",
 		      HALF_PAGES, faults);
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0 */
+
+	k_mem_paging_stats_get(&stats);
+#if CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0
+	zassert_not_equal(stats.pagefaults.prefetched, 0UL, "no page prefetched");
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0 */
+#ifdef CONFIG_DEMAND_PAGING_REFAULT_STATS
+	/* The pages written were just paged out */
+	zassert_not_equal(stats.refaults.cnt, 0UL, "no refault recorded");
+#else
+	ARG_UNUSED(stats);
+#endif /* CONFIG_DEMAND_PAGING_REFAULT_STATS */
 
 	ret = k_mem_page_out(arena, arena_size);
 	zassert_equal(ret, -ENOMEM, "k_mem_page_out should have failed");
@@ -264,6 +306,7 @@ static void test_k_mem_page_out(void)
 ZTEST(demand_paging_api, test_k_mem_page_in)
 {
 	unsigned long faults;
+	struct k_mem_paging_stats_t stats;
 	int key, ret;
 
 	/* Lock IRQs to prevent other pagefaults from happening while we
@@ -449,6 +492,12 @@ ZTEST_USER(demand_paging_stat, test_user_get_hist)
 	zassert_true(print_histogram(&hist),
 		     "should have non-zero counts in histogram.");
 	printk("\n");
+
+	printk("Page Fault Histogram:\n");
+	k_mem_paging_histogram_page_fault_get(&hist);
+	zassert_true(print_histogram(&hist),
+		     "should have non-zero counts in histogram.");
+	printk("\n");
 }
 
 void *demand_paging_api_setup(void)
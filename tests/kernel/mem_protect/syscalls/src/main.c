@@ -5,6 +5,7 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/kernel/syscall_batch.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/ztest.h>
 #include <zephyr/linker/linker-defs.h>
@@ -510,6 +511,41 @@ ZTEST(syscalls, test_syscall_context)
 	k_thread_user_mode_enter(test_syscall_context_user, NULL, NULL, NULL);
 }
 
+#ifdef CONFIG_SYSCALL_BATCH
+K_SEM_DEFINE(batch_sem, 0, 1);
+K_MSGQ_DEFINE(batch_msgq, sizeof(uint32_t), 1, 4);
+
+/* Show that a batch runs every entry in order and reports each result */
+ZTEST_USER(syscalls, test_syscall_batch)
+{
+	uint32_t in = 0x12345678U, out = 0U;
+	struct k_syscall_batch_entry entries[] = {
+		{ .op = K_SYSCALL_BATCH_SEM_GIVE, .obj = &batch_sem },
+		{ .op = K_SYSCALL_BATCH_SEM_TAKE, .obj = &batch_sem, .timeout = K_NO_WAIT },
+		{ .op = K_SYSCALL_BATCH_SEM_TAKE, .obj = &batch_sem, .timeout = K_NO_WAIT },
+		{ .op = K_SYSCALL_BATCH_MSGQ_PUT, .obj = &batch_msgq, .data = &in,
+		  .timeout = K_NO_WAIT },
+		{ .op = K_SYSCALL_BATCH_MSGQ_GET, .obj = &batch_msgq, .data = &out,
+		  .timeout = K_NO_WAIT },
+		{ .op = UINT32_MAX, .obj = &batch_sem },
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		entries[i].result = 1;
+	}
+
+	zassert_equal(k_syscall_batch(entries, ARRAY_SIZE(entries)), 2,
+		      "wrong number of failed entries");
+	zassert_equal(entries[0].result, 0);
+	zassert_equal(entries[1].result, 0);
+	zassert_equal(entries[2].result, -EBUSY);
+	zassert_equal(entries[3].result, 0);
+	zassert_equal(entries[4].result, 0);
+	zassert_equal(entries[5].result, -EINVAL);
+	zassert_equal(out, in, "message not received");
+}
+#endif /* CONFIG_SYSCALL_BATCH */
+
 K_HEAP_DEFINE(test_heap, BUF_SIZE * (4 * MAX_NR_THREADS));
 
 void *syscalls_setup(void)
@@ -517,6 +553,9 @@ void *syscalls_setup(void)
 	sprintf(kernel_string, "this is a kernel string");
 	sprintf(user_string, "this is a user string");
 	k_thread_heap_assign(k_current_get(), &test_heap);
+#ifdef CONFIG_SYSCALL_BATCH
+	k_thread_access_grant(k_current_get(), &batch_sem, &batch_msgq);
+#endif /* CONFIG_SYSCALL_BATCH */
 
 	return NULL;
 }
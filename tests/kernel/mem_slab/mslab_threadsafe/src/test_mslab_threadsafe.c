@@ -91,4 +91,12 @@ ZTEST(mslab_threadsafe, test_mslab_threadsafe)
 		zassert_false(ret, "k_thread_join() failed");
 		zassert_true(success[i], "thread %d failed", i);
 	}
+
+	/* all blocks must be accounted for as free again */
+	for (int i = 0; i < SLAB_NUM; i++) {
+		zassert_equal(k_mem_slab_num_used_get(slabs[i]), 0,
+			      "slab %d has blocks in use", i);
+		zassert_equal(k_mem_slab_num_free_get(slabs[i]), SLAB_BLOCKS,
+			      "slab %d lost blocks", i);
+	}
 }
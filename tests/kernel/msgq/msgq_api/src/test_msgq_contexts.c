@@ -306,8 +306,13 @@ ZTEST(msgq_api, test_msgq_thread_overflow)
 	msgq_thread_overflow(&kmsgq);
 
 	/*verify the write pointer not reset to the buffer start*/
+#ifdef CONFIG_MSGQ_MPSC
+	zassert_false(atomic_get(&msgq.mpsc_reserve) == 0,
+		"Invalid add operation of message queue");
+#else
 	zassert_false(msgq.write_ptr == msgq.buffer_start,
 		"Invalid add operation of message queue");
+#endif
 }
 
 #ifdef CONFIG_USERSPACE
@@ -447,8 +447,8 @@ ZTEST(mutex_complex, test_supervisor_access)
 {
 	int rv;
 
-#ifdef CONFIG_USERSPACE
-	/* coverage for get_k_mutex checks */
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST)
+	/* coverage for get_k_mutex checks, which the fast path does not reach */
 	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
 	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
@@ -467,7 +467,10 @@ ZTEST(mutex_complex, test_supervisor_access)
 
 ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 {
-#ifdef CONFIG_USERSPACE
+	/* With CONFIG_SYS_MUTEX_FAST, the mutex is accessed directly by
+	 * the caller, an inaccessible mutex faults as any other memory.
+	 */
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST)
 	int rv;
 
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
@@ -479,6 +482,58 @@ ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 #endif /* CONFIG_USERSPACE */
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+DEFINE_PARTICIPANT_THREAD(13);
+static ZTEST_BMEM bool no_access_locked;
+
+void thread_13(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	ztest_set_fault_valid(true);
+	(void)sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
+
+	/* should not go here */
+	no_access_locked = true;
+}
+
+ZTEST(mutex_complex, test_user_access_fault)
+{
+	/* With CONFIG_SYS_MUTEX_FAST, the mutex is accessed directly by
+	 * the caller, an inaccessible mutex faults as any other memory.
+	 */
+	CREATE_PARTICIPANT_THREAD(13, K_PRIO_PREEMPT(0));
+	START_PARTICIPANT_THREAD(13);
+	JOIN_PARTICIPANT_THREAD(13);
+
+	zassert_false(no_access_locked, "accessed mutex not in memory domain");
+}
+
+static ZTEST_BMEM SYS_MUTEX_DEFINE(forged_mutex);
+static ZTEST_BMEM int not_a_thread;
+
+ZTEST_USER_OR_NOT(mutex_complex, test_forged_owner)
+{
+	int rv;
+
+	/* The mutex word is in user memory, the kernel must not boost
+	 * whatever it names.
+	 */
+	atomic_set(&forged_mutex.val, (atomic_val_t)&not_a_thread);
+
+	rv = sys_mutex_lock(&forged_mutex, K_MSEC(10));
+	zassert_true(rv == -EINVAL, "accepted an owner that is not a thread");
+
+	sys_mutex_init(&forged_mutex);
+	rv = sys_mutex_lock(&forged_mutex, K_NO_WAIT);
+	zassert_true(rv == 0, "failed to lock a reinitialized mutex");
+	rv = sys_mutex_unlock(&forged_mutex);
+	zassert_true(rv == 0, "failed to unlock a reinitialized mutex");
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
+
 /*test case main entry*/
 static void *sys_mutex_tests_setup(void)
 {
@@ -0,0 +1,277 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+ZTEST_SUITE(k_pipe_claim, NULL, NULL, NULL, NULL, NULL);
+
+#define DUMMY_DATA_SIZE 16
+static struct k_thread thread;
+static K_THREAD_STACK_DEFINE(stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_pipe pipe;
+
+ZTEST(k_pipe_claim, test_write_claim_commit)
+{
+	uint8_t buffer[10];
+	uint8_t input[8];
+	uint8_t res[8];
+	uint8_t *area;
+
+	sys_rand_get(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_equal(k_pipe_write_claim(&pipe, &area, sizeof(input), K_NO_WAIT), sizeof(input),
+		"Failed to claim space in pipe");
+	memcpy(area, input, sizeof(input));
+
+	/* Nothing is visible before the commit */
+	zassert_equal(k_pipe_read(&pipe, res, 1, K_NO_WAIT), -EAGAIN,
+		"Claimed data should not be readable");
+
+	zassert_equal(k_pipe_write_commit(&pipe, sizeof(input)), sizeof(input),
+		"Failed to commit claimed space");
+	zassert_equal(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT), sizeof(res),
+		"Failed to read committed data");
+	zassert_mem_equal(input, res, sizeof(input), "Unexpected data received from pipe");
+}
+
+ZTEST(k_pipe_claim, test_read_claim_finish)
+{
+	uint8_t buffer[10];
+	uint8_t input[8];
+	uint8_t *area;
+
+	sys_rand_get(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_equal(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT), sizeof(input),
+		"Failed to write to pipe");
+	zassert_equal(k_pipe_read_claim(&pipe, &area, 5, K_NO_WAIT), 5,
+		"Failed to claim data from pipe");
+	zassert_mem_equal(input, area, 5, "Unexpected data claimed from pipe");
+	zassert_equal(k_pipe_read_finish(&pipe, 5), 5, "Failed to release claimed data");
+
+	zassert_equal(k_pipe_read_claim(&pipe, &area, sizeof(input), K_NO_WAIT), 3,
+		"Failed to claim remaining data from pipe");
+	zassert_mem_equal(&input[5], area, 3, "Unexpected data claimed from pipe");
+
+	/* Only what was finished leaves the pipe */
+	zassert_equal(k_pipe_read_finish(&pipe, 1), 1, "Failed to release claimed data");
+	zassert_equal(k_pipe_read_claim(&pipe, &area, sizeof(input), K_NO_WAIT), 2,
+		"Unfinished data should stay in the pipe");
+	zassert_equal(k_pipe_read_finish(&pipe, 2), 2, "Failed to release claimed data");
+	zassert_equal(k_pipe_read_claim(&pipe, &area, sizeof(input), K_NO_WAIT), -EAGAIN,
+		"Pipe should be empty");
+}
+
+ZTEST(k_pipe_claim, test_claim_wrap_around)
+{
+	uint8_t buffer[12];
+	uint8_t input[8];
+	uint8_t res[8];
+	uint8_t *area;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT), sizeof(input),
+		"Failed to write to pipe");
+	zassert_equal(k_pipe_read(&pipe, res, 5, K_NO_WAIT), 5, "Failed to read from pipe");
+
+	/* Claims stop at the end of the buffer */
+	zassert_equal(k_pipe_write_claim(&pipe, &area, sizeof(input), K_NO_WAIT), 4,
+		"Claim should stop where the buffer wraps");
+	zassert_equal(k_pipe_write_commit(&pipe, 4), 4, "Failed to commit claimed space");
+	zassert_equal(k_pipe_write_claim(&pipe, &area, sizeof(input), K_NO_WAIT), 5,
+		"Claim should restart at the beginning of the buffer");
+	zassert_equal_ptr(area, buffer, "Claim should restart at the beginning of the buffer");
+	zassert_equal(k_pipe_write_commit(&pipe, 0), 0, "Failed to drop claimed space");
+}
+
+ZTEST(k_pipe_claim, test_claim_errors)
+{
+	uint8_t buffer[10];
+	uint8_t data[4] = {};
+	uint8_t *area;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_equal(k_pipe_write_commit(&pipe, 1), -EINVAL, "Commit without claim");
+	zassert_equal(k_pipe_read_finish(&pipe, 1), -EINVAL, "Finish without claim");
+
+	zassert_equal(k_pipe_write_claim(&pipe, &area, 4, K_NO_WAIT), 4, "Failed to claim");
+	zassert_equal(k_pipe_write_claim(&pipe, &area, 4, K_NO_WAIT), -EBUSY,
+		"Only one write claim can be outstanding");
+	zassert_equal(k_pipe_write(&pipe, data, sizeof(data), K_NO_WAIT), -EBUSY,
+		"Write should fail while a claim is outstanding");
+	zassert_equal(k_pipe_write_commit(&pipe, 5), -EINVAL, "Commit beyond the claim");
+	zassert_equal(k_pipe_write_commit(&pipe, 4), 4, "Failed to commit");
+
+	zassert_equal(k_pipe_read_claim(&pipe, &area, 4, K_NO_WAIT), 4, "Failed to claim");
+	zassert_equal(k_pipe_read(&pipe, data, sizeof(data), K_NO_WAIT), -EBUSY,
+		"Read should fail while a claim is outstanding");
+	zassert_equal(k_pipe_read_finish(&pipe, 5), -EINVAL, "Finish beyond the claim");
+
+	/* Reset drops outstanding claims */
+	k_pipe_reset(&pipe);
+	zassert_equal(k_pipe_read_finish(&pipe, 4), -EINVAL, "Claim should be dropped by reset");
+
+	zassert_equal(k_pipe_write_claim(&pipe, &area, 4, K_NO_WAIT), 4, "Failed to claim");
+	k_pipe_close(&pipe);
+	zassert_equal(k_pipe_write_commit(&pipe, 4), -EPIPE, "Commit to a closed pipe");
+	zassert_equal(k_pipe_read_claim(&pipe, &area, 4, K_NO_WAIT), -EPIPE,
+		"Closed and empty pipe should return -EPIPE");
+}
+
+static void thread_write(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t garbage[DUMMY_DATA_SIZE] = {};
+
+	zassert_equal(k_pipe_write((struct k_pipe *)arg1, garbage, sizeof(garbage), K_FOREVER),
+		sizeof(garbage), "Failed to write to pipe");
+}
+
+static void thread_read(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t garbage[DUMMY_DATA_SIZE];
+
+	zassert_equal(k_pipe_read((struct k_pipe *)arg1, garbage, sizeof(garbage), K_FOREVER),
+		sizeof(garbage), "Failed to read from pipe");
+}
+
+ZTEST(k_pipe_claim, test_read_claim_wait)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t *area;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_write, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+	zassert_equal(k_pipe_read_claim(&pipe, &area, DUMMY_DATA_SIZE, K_MSEC(1000)),
+		DUMMY_DATA_SIZE, "Read claim should be woken up by the writer");
+	zassert_equal(k_pipe_read_finish(&pipe, DUMMY_DATA_SIZE), DUMMY_DATA_SIZE,
+		"Failed to release claimed data");
+	k_thread_join(tid, K_FOREVER);
+}
+
+ZTEST(k_pipe_claim, test_write_claim_wait)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t garbage[DUMMY_DATA_SIZE] = {};
+	uint8_t *area;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT), sizeof(garbage),
+		"Failed to fill pipe");
+
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_read, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+	zassert_equal(k_pipe_write_claim(&pipe, &area, DUMMY_DATA_SIZE, K_MSEC(1000)),
+		DUMMY_DATA_SIZE, "Write claim should be woken up by the reader");
+	zassert_equal(k_pipe_write_commit(&pipe, 0), 0, "Failed to drop claimed space");
+	k_thread_join(tid, K_FOREVER);
+}
+
+/*
+ * Waiters woken up while another thread takes a claim must not touch the
+ * ring buffer: the other thread's claim would be committed or consumed by
+ * them. These run on a single CPU so that the waiter only runs once the
+ * claim is taken.
+ */
+ZTEST_SUITE(k_pipe_claim_1cpu, NULL, NULL, ztest_simple_1cpu_before, ztest_simple_1cpu_after,
+	    NULL);
+
+static int waiter_rc;
+
+static void thread_write_waiter(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t data[4];
+
+	memset(data, 'B', sizeof(data));
+	waiter_rc = k_pipe_write((struct k_pipe *)arg1, data, sizeof(data), K_FOREVER);
+}
+
+static void thread_read_claim_waiter(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *area;
+
+	waiter_rc = k_pipe_read_claim((struct k_pipe *)arg1, &area, DUMMY_DATA_SIZE, K_FOREVER);
+}
+
+ZTEST(k_pipe_claim_1cpu, test_write_claim_while_waiting)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[DUMMY_DATA_SIZE];
+	uint8_t res[DUMMY_DATA_SIZE];
+	uint8_t *area;
+
+	memset(input, 'A', sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT), sizeof(input),
+		"Failed to fill pipe");
+
+	/* The writer blocks on the full pipe */
+	waiter_rc = 0;
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_write_waiter, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_NO_WAIT);
+	zassert_true(tid, "k_thread_create failed");
+	k_sleep(K_MSEC(10));
+
+	/* Wake it up, then claim the freed space before it runs */
+	zassert_equal(k_pipe_read(&pipe, res, 4, K_NO_WAIT), 4, "Failed to read from pipe");
+	zassert_equal(k_pipe_write_claim(&pipe, &area, 4, K_NO_WAIT), 4, "Failed to claim");
+	memset(area, 'C', 4);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(waiter_rc, -EBUSY, "Waiting writer should see the claim");
+
+	zassert_equal(k_pipe_write_commit(&pipe, 4), 4, "Failed to commit claimed space");
+	zassert_equal(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT), sizeof(res),
+		"Failed to read from pipe");
+	zassert_mem_equal(res, input, sizeof(res) - 4, "Unexpected data received from pipe");
+	zassert_mem_equal(&res[sizeof(res) - 4], "CCCC", 4,
+		"Claimed data should be committed as written");
+}
+
+ZTEST(k_pipe_claim_1cpu, test_read_claim_while_waiting)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[8];
+	uint8_t res[8];
+	uint8_t *area;
+
+	sys_rand_get(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	/* The reader blocks on the empty pipe */
+	waiter_rc = 0;
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_read_claim_waiter, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_NO_WAIT);
+	zassert_true(tid, "k_thread_create failed");
+	k_sleep(K_MSEC(10));
+
+	/* Wake it up, then claim the data before it runs */
+	zassert_equal(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT), sizeof(input),
+		"Failed to write to pipe");
+	zassert_equal(k_pipe_read_claim(&pipe, &area, 4, K_NO_WAIT), 4, "Failed to claim");
+	zassert_mem_equal(area, input, 4, "Unexpected data claimed from pipe");
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(waiter_rc, -EBUSY, "Waiting reader should see the claim");
+
+	/* Only the finished claim left the pipe */
+	zassert_equal(k_pipe_read_finish(&pipe, 4), 4, "Failed to release claimed data");
+	zassert_equal(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT), 4,
+		"Failed to read remaining data");
+	zassert_mem_equal(res, &input[4], 4, "Unexpected data received from pipe");
+}
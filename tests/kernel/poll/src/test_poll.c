@@ -876,3 +876,129 @@ ZTEST(poll_api_1cpu, test_poll_zero_events)
 
 	zassert_equal(k_poll(&event, 0, K_MSEC(50)), -EAGAIN);
 }
+
+/* verify that a poll signal wakes up all its pollers */
+static struct k_poll_signal multi_signal;
+static int multi_signal_rc[2];
+
+static void multi_signal_poller(void *p1, void *p2, void *p3)
+{
+	int *rc = p1;
+	struct k_poll_event event;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &multi_signal);
+
+	*rc = k_poll(&event, 1, K_FOREVER);
+	if (*rc == 0 && event.state != K_POLL_STATE_SIGNALED) {
+		*rc = -EINVAL;
+	}
+}
+
+/**
+ * @brief Test that raising a poll signal wakes up all the threads polling it
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_signal_raise()
+ */
+ZTEST(poll_api_1cpu, test_poll_signal_multi_pollers)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	k_poll_signal_init(&multi_signal);
+	multi_signal_rc[0] = -EBUSY;
+	multi_signal_rc[1] = -EBUSY;
+
+	k_thread_create(&test_thread, test_stack, K_THREAD_STACK_SIZEOF(test_stack),
+			multi_signal_poller, &multi_signal_rc[0], NULL, NULL,
+			prio - 1, 0, K_NO_WAIT);
+	k_thread_create(&test_loprio_thread, test_loprio_stack,
+			K_THREAD_STACK_SIZEOF(test_loprio_stack),
+			multi_signal_poller, &multi_signal_rc[1], NULL, NULL,
+			prio - 1, 0, K_NO_WAIT);
+
+	k_poll_signal_raise(&multi_signal, SIGNAL_RESULT);
+
+	zassert_equal(k_thread_join(&test_thread, K_MSEC(100)), 0);
+	zassert_equal(k_thread_join(&test_loprio_thread, K_MSEC(100)), 0);
+	zassert_equal(multi_signal_rc[0], 0);
+	zassert_equal(multi_signal_rc[1], 0);
+}
+
+/* verify that k_poll() reports all the events ready when it wakes up */
+static struct k_sem batch_sems[2];
+
+static void batch_other_poller(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event event;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+			  &batch_sems[1]);
+	(void)k_poll(&event, 1, K_FOREVER);
+}
+
+static void batch_giver(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Cooperative: both semaphores are given before any poller runs */
+	k_sem_give(&batch_sems[0]);
+	k_sem_give(&batch_sems[1]);
+}
+
+/**
+ * @brief Test that k_poll() returns all the events ready when it wakes up
+ *
+ * The second semaphore notifies a higher priority poller rather than the
+ * thread under test, which must still find it available when woken up by the
+ * first semaphore.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll()
+ */
+ZTEST(poll_api_1cpu, test_poll_batch_ready)
+{
+	const int main_low_prio = 10;
+	int old_prio = k_thread_priority_get(k_current_get());
+	struct k_poll_event events[2];
+	int rc;
+
+	k_sem_init(&batch_sems[0], 0, 1);
+	k_sem_init(&batch_sems[1], 0, 1);
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &batch_sems[i]);
+	}
+
+	k_thread_priority_set(k_current_get(), main_low_prio);
+
+	k_thread_create(&test_thread, test_stack, K_THREAD_STACK_SIZEOF(test_stack),
+			batch_other_poller, NULL, NULL, NULL,
+			main_low_prio - 1, 0, K_NO_WAIT);
+	k_thread_create(&test_loprio_thread, test_loprio_stack,
+			K_THREAD_STACK_SIZEOF(test_loprio_stack),
+			batch_giver, NULL, NULL, NULL,
+			K_PRIO_COOP(1), 0, K_MSEC(10));
+
+	rc = k_poll(events, ARRAY_SIZE(events), K_SECONDS(1));
+
+	k_thread_priority_set(k_current_get(), old_prio);
+
+	zassert_equal(rc, 0);
+	zassert_equal(events[0].state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_equal(events[1].state, K_POLL_STATE_SEM_AVAILABLE);
+
+	zassert_equal(k_thread_join(&test_thread, K_MSEC(100)), 0);
+	zassert_equal(k_thread_join(&test_loprio_thread, K_MSEC(100)), 0);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define NUM_SET_EVENTS 4
+#define SET_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_poll_set set;
+static struct k_sem set_sems[NUM_SET_EVENTS];
+static struct k_poll_event set_events[NUM_SET_EVENTS];
+static struct k_poll_signal set_signal;
+static struct k_thread set_thread;
+static K_THREAD_STACK_DEFINE(set_stack, SET_STACK_SIZE);
+
+static void set_setup(void)
+{
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < NUM_SET_EVENTS; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		k_poll_set_add(&set, &set_events[i]);
+	}
+}
+
+static void set_teardown(void)
+{
+	for (int i = 0; i < NUM_SET_EVENTS; i++) {
+		k_poll_set_remove(&set, &set_events[i]);
+	}
+}
+
+/**
+ * @brief Test that a poll set only reports the ready events
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_ready_only)
+{
+	struct k_poll_event *ready[NUM_SET_EVENTS];
+
+	set_setup();
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 0);
+
+	k_sem_give(&set_sems[2]);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[2]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/* Level-triggered: reported again while the semaphore is available */
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[2]);
+
+	zassert_equal(k_sem_take(&set_sems[2], K_NO_WAIT), 0);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_MSEC(10)), 0);
+
+	set_teardown();
+}
+
+/**
+ * @brief Test that removed events are no longer reported
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_remove)
+{
+	struct k_poll_event *ready[NUM_SET_EVENTS];
+
+	set_setup();
+
+	k_poll_set_remove(&set, &set_events[0]);
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 0);
+
+	/* Removing an event sitting on the ready list */
+	k_sem_give(&set_sems[1]);
+	k_poll_set_remove(&set, &set_events[1]);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 0);
+
+	k_sem_take(&set_sems[0], K_NO_WAIT);
+	k_sem_take(&set_sems[1], K_NO_WAIT);
+
+	set_teardown();
+}
+
+/**
+ * @brief Test that edge-triggered events are only reported once per signal
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_edge_triggered)
+{
+	struct k_poll_event *ready[NUM_SET_EVENTS];
+	struct k_poll_event edge_event;
+	struct k_sem edge_sem;
+
+	set_setup();
+
+	k_sem_init(&edge_sem, 0, 2);
+	k_poll_event_init(&edge_event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_EDGE_TRIGGERED, &edge_sem);
+	k_poll_set_add(&set, &edge_event);
+
+	k_sem_give(&edge_sem);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &edge_event);
+	zassert_equal(edge_event.state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/* Not reported again while the semaphore stays available */
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 0);
+
+	/* Reported again on the next give, with its state reset */
+	k_sem_give(&edge_sem);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &edge_event);
+	zassert_equal(edge_event.state, K_POLL_STATE_SEM_AVAILABLE);
+
+	k_poll_set_remove(&set, &edge_event);
+	k_sem_give(&edge_sem);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 0);
+
+	set_teardown();
+}
+
+static void set_raise_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sleep(K_MSEC(10));
+	k_poll_signal_raise(&set_signal, 0x1234);
+}
+
+/**
+ * @brief Test that a thread blocked on a poll set is woken up
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait(), k_poll_signal_raise()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event *ready[NUM_SET_EVENTS];
+	struct k_poll_event signal_event;
+
+	set_setup();
+
+	k_poll_signal_init(&set_signal);
+	k_poll_event_init(&signal_event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &set_signal);
+	k_poll_set_add(&set, &signal_event);
+
+	k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			set_raise_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_FOREVER), 1);
+	zassert_equal_ptr(ready[0], &signal_event);
+	zassert_equal(signal_event.state, K_POLL_STATE_SIGNALED);
+
+	k_thread_join(&set_thread, K_FOREVER);
+
+	k_poll_set_remove(&set, &signal_event);
+	set_teardown();
+}
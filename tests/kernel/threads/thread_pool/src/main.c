@@ -0,0 +1,158 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/thread_pool.h>
+#include <zephyr/ztest.h>
+
+#define NUM_THREADS	2
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define PRIO		K_PRIO_PREEMPT(1)
+
+K_THREAD_POOL_DEFINE(pool, NUM_THREADS, STACK_SIZE, 0);
+
+static K_SEM_DEFINE(release_sem, 0, NUM_THREADS);
+
+static void *entry_args[3];
+static k_tid_t entry_tid;
+
+static void record_entry(void *p1, void *p2, void *p3)
+{
+	entry_args[0] = p1;
+	entry_args[1] = p2;
+	entry_args[2] = p3;
+	entry_tid = k_current_get();
+}
+
+static void blocking_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&release_sem, K_FOREVER);
+}
+
+/**
+ * @brief Test that a pool thread runs its entry point with its parameters
+ */
+ZTEST(thread_pool, test_spawn_join)
+{
+	k_tid_t tid;
+
+	tid = k_thread_pool_spawn(&pool, record_entry, INT_TO_POINTER(1), INT_TO_POINTER(2),
+				  INT_TO_POINTER(3), PRIO, K_NO_WAIT);
+	zassert_not_null(tid);
+	zassert_ok(k_thread_pool_join(&pool, tid, K_FOREVER));
+
+	zassert_equal(entry_tid, tid);
+	zassert_equal(POINTER_TO_INT(entry_args[0]), 1);
+	zassert_equal(POINTER_TO_INT(entry_args[1]), 2);
+	zassert_equal(POINTER_TO_INT(entry_args[2]), 3);
+}
+
+/**
+ * @brief Test that joined threads are reused instead of creating new ones
+ */
+ZTEST(thread_pool, test_reuse)
+{
+	k_tid_t first, tid;
+
+	first = k_thread_pool_spawn(&pool, record_entry, NULL, NULL, NULL, PRIO, K_NO_WAIT);
+	zassert_not_null(first);
+	zassert_ok(k_thread_pool_join(&pool, first, K_FOREVER));
+
+	for (int i = 0; i < 10; i++) {
+		tid = k_thread_pool_spawn(&pool, record_entry, INT_TO_POINTER(i), NULL, NULL,
+					  PRIO, K_NO_WAIT);
+		zassert_equal(tid, first, "thread not reused");
+		zassert_ok(k_thread_pool_join(&pool, tid, K_FOREVER));
+		zassert_equal(POINTER_TO_INT(entry_args[0]), i);
+	}
+
+	zassert_true(pool.num_created <= NUM_THREADS);
+}
+
+/**
+ * @brief Test spawning from an exhausted pool and joining a running thread
+ */
+ZTEST(thread_pool, test_exhausted)
+{
+	k_tid_t tids[NUM_THREADS];
+	k_tid_t tid;
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		tids[i] = k_thread_pool_spawn(&pool, blocking_entry, NULL, NULL, NULL, PRIO,
+					      K_NO_WAIT);
+		zassert_not_null(tids[i]);
+	}
+
+	tid = k_thread_pool_spawn(&pool, record_entry, NULL, NULL, NULL, PRIO, K_NO_WAIT);
+	zassert_is_null(tid, "spawned from an exhausted pool");
+	tid = k_thread_pool_spawn(&pool, record_entry, NULL, NULL, NULL, PRIO, K_MSEC(10));
+	zassert_is_null(tid, "spawned from an exhausted pool");
+
+	zassert_equal(k_thread_pool_join(&pool, tids[0], K_NO_WAIT), -EBUSY);
+	zassert_equal(k_thread_pool_join(&pool, tids[0], K_MSEC(10)), -EAGAIN);
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_sem_give(&release_sem);
+	}
+	for (int i = 0; i < NUM_THREADS; i++) {
+		zassert_ok(k_thread_pool_join(&pool, tids[i], K_FOREVER));
+	}
+
+	tid = k_thread_pool_spawn(&pool, record_entry, NULL, NULL, NULL, PRIO, K_NO_WAIT);
+	zassert_not_null(tid);
+	zassert_ok(k_thread_pool_join(&pool, tid, K_FOREVER));
+}
+
+/**
+ * @brief Test joining a thread which is not part of the pool
+ */
+ZTEST(thread_pool, test_join_invalid)
+{
+	zassert_equal(k_thread_pool_join(&pool, k_current_get(), K_NO_WAIT), -EINVAL);
+}
+
+static bool state_clean;
+
+static void state_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Leave state behind for the next entry point to find */
+	state_clean = (errno == 0);
+	errno = EBADF;
+#ifdef CONFIG_THREAD_CUSTOM_DATA
+	state_clean = state_clean && (k_thread_custom_data_get() == NULL);
+	k_thread_custom_data_set(p1);
+#endif
+}
+
+/**
+ * @brief Test that a reused thread starts each entry point without the errno
+ * and custom data of the previous one
+ */
+ZTEST(thread_pool, test_state_cleared)
+{
+	k_tid_t tid;
+
+	for (int i = 0; i < NUM_THREADS + 1; i++) {
+		state_clean = false;
+
+		tid = k_thread_pool_spawn(&pool, state_entry, &state_clean, NULL, NULL, PRIO,
+					  K_NO_WAIT);
+		zassert_not_null(tid);
+		zassert_ok(k_thread_pool_join(&pool, tid, K_FOREVER));
+
+		zassert_true(state_clean, "state of the previous entry point leaked");
+	}
+}
+
+ZTEST_SUITE(thread_pool, NULL, NULL, NULL, NULL, NULL);
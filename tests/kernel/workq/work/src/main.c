@@ -328,6 +328,52 @@ ZTEST(work_1cpu, test_1cpu_simple_queue)
 	zassert_equal(rc, 0);
 }
 
+/* Single-CPU check submitting a batch of items. */
+ZTEST(work_1cpu, test_1cpu_batch_queue)
+{
+	struct k_work *batch[] = { &common_work, &common_work1, &common_work };
+	int rc;
+
+	/* Reset state and use the non-blocking handler */
+	reset_counters();
+	k_work_init(&common_work, counter_handler);
+	k_work_init(&common_work1, counter_handler);
+
+	/* The duplicate entry is already queued, which counts as
+	 * success.
+	 */
+	rc = k_work_submit_batch_to_queue(&coophi_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, ARRAY_SIZE(batch));
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_QUEUED);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_QUEUED);
+
+	/* Shouldn't have been started since test thread is
+	 * cooperative.
+	 */
+	zassert_equal(coophi_counter(), 0);
+
+	/* Let them run, then check both finished once. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(coophi_counter(), 2);
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	zassert_equal(k_work_busy_get(&common_work1), 0);
+
+	/* Flush the sync state from completion */
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0);
+
+	/* Rejected submissions are not counted */
+	rc = k_work_submit_batch_to_queue(&not_start_queue, batch, 2);
+	zassert_equal(rc, 0);
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	zassert_equal(k_work_busy_get(&common_work1), 0);
+
+	/* An empty batch is a no-op */
+	rc = k_work_submit_batch_to_queue(&coophi_queue, NULL, 0);
+	zassert_equal(rc, 0);
+}
+
 /* Basic SMP check submitting with a non-blocking handler. */
 ZTEST(work, test_smp_simple_queue)
 {
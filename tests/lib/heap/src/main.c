@@ -9,6 +9,8 @@
 #include <zephyr/sys/heap_listener.h>
 #include <inttypes.h>
 
+#include "../../../../lib/heap/heap.h"
+
 /* Guess at a value for heap size based on available memory on the
  * platform, with workarounds.
  */
@@ -41,15 +43,6 @@
 #define BIG_HEAP_SZ MIN(256 * 1024, MEMSZ / 3)
 #define SMALL_HEAP_SZ MIN(BIG_HEAP_SZ, 2048)
 
-/* With enabling SYS_HEAP_RUNTIME_STATS, the size of struct z_heap
- * will increase 16 bytes on 64 bit CPU.
- */
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-#define SOLO_FREE_HEADER_HEAP_SZ (80)
-#else
-#define SOLO_FREE_HEADER_HEAP_SZ (64)
-#endif
-
 #define SCRATCH_SZ (sizeof(heapmem) / 2)
 
 /* The test memory.  Make them pointer arrays for robust alignment
@@ -252,20 +245,120 @@ ZTEST(lib_heap, test_big_heap)
  * - 1: chunk mem
  * - s: solo free header
  * - f: end marker / footer
+ *
+ * Chunk0 grows with struct z_heap (runtime stats, size-class cache), so
+ * the heap size giving that layout is computed like sys_heap_init() lays
+ * out chunk0 on a big heap.
  */
+static size_t solo_free_header_heap_sz(void)
+{
+	for (chunksz_t heap_sz = 4U; ; heap_sz++) {
+		/* bucket_idx() + 1, with a minimum chunk size of 2 units */
+		int nb_buckets = 32 - __builtin_clz(heap_sz - 1U);
+		chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
+						nb_buckets * sizeof(struct z_heap_bucket));
+
+		/* chunk0, 2 units for the allocation and 1 for the solo header */
+		if (chunk0_size + 3U == heap_sz) {
+			/* plus the footer */
+			return (heap_sz + 1U) * CHUNK_UNIT;
+		}
+	}
+}
+
 ZTEST(lib_heap, test_solo_free_header)
 {
 	struct sys_heap heap;
+	struct z_heap *h;
+	chunkid_t c;
+	void *p;
 
 	TC_PRINT("Testing solo free header in a heap\n");
 
-	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
-	if (sizeof(void *) > 4U) {
-		sys_heap_alloc(&heap, 1);
-		zassert_true(sys_heap_validate(&heap), "");
-	} else {
+	if (sizeof(void *) <= 4U) {
+		ztest_test_skip();
+	}
+
+	sys_heap_init(&heap, heapmem, solo_free_header_heap_sz());
+	h = heap.heap;
+
+	p = sys_heap_alloc(&heap, 1);
+	zassert_not_null(p, "");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	c = ((uint8_t *)p - chunk_header_bytes(h) - (uint8_t *)chunk_buf(h)) / CHUNK_UNIT;
+	zassert_true(solo_free_header(h, right_chunk(h, c)), "");
+}
+
+static void *rawalloc(void *arg, size_t bytes)
+{
+	return sys_heap_alloc(arg, bytes);
+}
+
+static void rawfree(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+}
+
+/* Same workload as test_small_heap, but without the fill/validate
+ * overhead, so the cycle count reflects the allocator itself.  Mostly
+ * useful for comparing configurations (e.g. with and without
+ * CONFIG_SYS_HEAP_SIZE_CLASS_CACHE).
+ */
+ZTEST(lib_heap, test_throughput)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_stress(rawalloc, rawfree, &heap,
+			SMALL_HEAP_SZ, 8 * ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			50, &result);
+	zassert_true(sys_heap_validate(&heap), "");
+
+	log_result(SMALL_HEAP_SZ, &result);
+	TC_PRINT("%u cycles for %u ops (%u cycles/op)\n",
+		 result.elapsed_cycles, result.total_allocs + result.total_frees,
+		 result.elapsed_cycles / (result.total_allocs + result.total_frees));
+}
+
+/* A cached chunk is neither used nor free: it must be handed out again
+ * by an allocation of its size, and never grown into by its neighbor.
+ */
+ZTEST(lib_heap, test_size_class_cache)
+{
+	struct sys_heap heap;
+	void *a, *b, *c, *p;
+
+	if (!IS_ENABLED(CONFIG_SYS_HEAP_SIZE_CLASS_CACHE)) {
 		ztest_test_skip();
 	}
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	a = sys_heap_alloc(&heap, 16);
+	b = sys_heap_alloc(&heap, 16);
+	c = sys_heap_alloc(&heap, 16);
+	zassert_true(a != NULL && b != NULL && c != NULL, "");
+
+	sys_heap_free(&heap, b);
+	zassert_true(sys_heap_validate(&heap), "cached chunk not valid");
+
+	p = sys_heap_realloc(&heap, a, 24);
+	zassert_not_null(p, "");
+	zassert_not_equal(p, a, "realloc grew into a cached chunk");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* The caches are LIFO, and the realloc freed a */
+	zassert_equal(sys_heap_alloc(&heap, 16), a, "cached chunk not reused");
+	zassert_equal(sys_heap_alloc(&heap, 16), b, "cached chunk not reused");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	sys_heap_free(&heap, a);
+	sys_heap_free(&heap, b);
+	sys_heap_free(&heap, c);
+	sys_heap_free(&heap, p);
+	zassert_true(sys_heap_validate(&heap), "");
 }
 
 /* Simple clobber detection */
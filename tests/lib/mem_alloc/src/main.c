@@ -368,6 +368,53 @@ ZTEST(c_lib_dynamic_memalloc, test_memalloc_max)
 {
 	_test_memalloc_max();
 }
+
+#ifdef CONFIG_MULTITHREADING
+#define XFREE_BLOCKS 16
+#define XFREE_ROUNDS 8
+#define XFREE_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(xfree_stack, XFREE_STACK_SIZE);
+static struct k_thread xfree_thread;
+static void *xfree_ptrs[XFREE_BLOCKS];
+
+static void xfree_alloc(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < XFREE_BLOCKS; i++) {
+		xfree_ptrs[i] = malloc(BUF_LEN * (i + 1));
+		if (xfree_ptrs[i] != NULL) {
+			(void)memset(xfree_ptrs[i], 0xa5, BUF_LEN * (i + 1));
+		}
+	}
+}
+
+/**
+ * @brief Test freeing memory allocated by another thread
+ *
+ * Blocks are allocated by a short lived thread and freed by the test
+ * thread, repeatedly, which with CONFIG_COMMON_LIBC_MALLOC_ARENAS
+ * exercises frees crossing arenas.  Nothing may leak in the process.
+ */
+ZTEST(c_lib_dynamic_memalloc, test_malloc_cross_thread_free)
+{
+	for (int round = 0; round < XFREE_ROUNDS; round++) {
+		k_thread_create(&xfree_thread, xfree_stack, XFREE_STACK_SIZE,
+				xfree_alloc, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+		k_thread_join(&xfree_thread, K_FOREVER);
+
+		for (int i = 0; i < XFREE_BLOCKS; i++) {
+			zassert_not_null(xfree_ptrs[i], "round %d: malloc %d failed",
+					 round, i);
+			free(xfree_ptrs[i]);
+		}
+	}
+}
+#endif /* CONFIG_MULTITHREADING */
 #endif
 
 /**
@@ -1291,4 +1291,45 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+ZTEST(net_pkt_test_suite, test_net_pkt_clone_segment)
+{
+	static const char hdr[] = "HDR";
+	static const char data[] = "0123456789";
+	struct net_pkt *pkt, *seg;
+	size_t cursor_offset;
+	int res;
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, 3 + 10, NET_AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	res = net_pkt_write(pkt, hdr, 3);
+	zassert_equal(res, 0, "Pkt write failed");
+	res = net_pkt_write(pkt, data, 10);
+	zassert_equal(res, 0, "Pkt write failed");
+
+	net_pkt_set_family(pkt, NET_AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, 3);
+	cursor_offset = net_pkt_get_current_offset(pkt);
+
+	/* The headers and the second part of the payload */
+	seg = net_pkt_clone_segment(pkt, 3, 4, 6, K_NO_WAIT);
+	zassert_not_null(seg, "Segment not cloned");
+	zassert_equal(net_pkt_get_len(seg), 3 + 6, "Length mismatch");
+	zassert_equal(net_pkt_family(seg), NET_AF_INET, "Family mismatch");
+	zassert_equal(net_pkt_ip_hdr_len(seg), 3, "Header length mismatch");
+	zassert_equal(net_pkt_get_current_offset(pkt), cursor_offset,
+		      "Original cursor moved");
+
+	zassert_true(net_pkt_read(seg, small_buffer, 3 + 6) == 0, "Pkt read failed");
+	zassert_mem_equal(small_buffer, "HDR", 3, "Header mismatch");
+	zassert_mem_equal(small_buffer + 3, "456789", 6, "Data mismatch");
+	net_pkt_unref(seg);
+
+	/* Out of the packet */
+	seg = net_pkt_clone_segment(pkt, 3, 8, 4, K_NO_WAIT);
+	zassert_is_null(seg, "Segment cloned out of the packet");
+
+	net_pkt_unref(pkt);
+}
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -370,7 +370,7 @@ void tcp_server_block_thread(void *vps_sock, void *unused2, void *unused3)
 	test_close(new_sock);
 }
 
-void test_send_recv_large_common(int tcp_nodelay, int family)
+void test_send_recv_large_common(int tcp_nodelay, int family, const char *congestion)
 {
 	int rv;
 	int c_sock = 0;
@@ -409,6 +409,12 @@ void test_send_recv_large_common(int tcp_nodelay, int family)
 		&s_sock, NULL, NULL,
 		k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
 
+	if (congestion != NULL) {
+		rv = zsock_setsockopt(c_sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+				      congestion, strlen(congestion));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	}
+
 	test_connect(c_sock, s_saddr, addrlen);
 
 	rv = zsock_setsockopt(c_sock, NET_IPPROTO_TCP, ZSOCK_TCP_NODELAY,
@@ -471,39 +477,57 @@ static void restore_packet_loss_ratio(void)
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_normal)
 {
-	test_send_recv_large_common(0, NET_AF_INET);
+	test_send_recv_large_common(0, NET_AF_INET, NULL);
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(0, NET_AF_INET);
+	test_send_recv_large_common(0, NET_AF_INET, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(1, NET_AF_INET);
+	test_send_recv_large_common(1, NET_AF_INET, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_normal)
 {
-	test_send_recv_large_common(0, NET_AF_INET6);
+	test_send_recv_large_common(0, NET_AF_INET6, NULL);
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(0, NET_AF_INET6);
+	test_send_recv_large_common(0, NET_AF_INET6, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(1, NET_AF_INET6);
+	test_send_recv_large_common(1, NET_AF_INET6, NULL);
+	restore_packet_loss_ratio();
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss_cubic)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_CUBIC);
+
+	set_packet_loss_ratio();
+	test_send_recv_large_common(0, NET_AF_INET, "cubic");
+	restore_packet_loss_ratio();
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss_vegas)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_VEGAS);
+
+	set_packet_loss_ratio();
+	test_send_recv_large_common(0, NET_AF_INET, "vegas");
 	restore_packet_loss_ratio();
 }
 
@@ -2542,6 +2566,45 @@ ZTEST(net_socket_tcp, test_so_keepalive_opt)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion_opt)
+{
+	struct net_sockaddr_in bind_addr4;
+	char optval[16];
+	net_socklen_t optlen = sizeof(optval);
+	int sock, ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	/* New Reno is the default */
+	ret = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, optval, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(optval, "reno", "getsockopt got invalid value");
+	zassert_equal(optlen, sizeof("reno"), "getsockopt got invalid size");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+				       "cubic", sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(optval);
+		ret = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+				       optval, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_str_equal(optval, "cubic", "getsockopt got invalid value");
+	}
+
+	/* Unknown algorithm */
+	ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, "bbr", 3);
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt got invalid errno (%d)", errno);
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 static void test_prepare_keepalive_socks(int *c_sock, int *s_sock, int *new_sock)
 {
 	struct net_sockaddr_in c_saddr, s_saddr;
@@ -30,6 +30,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 
 #include "ipv4.h"
 #include "ipv6.h"
+#include "net_private.h"
 #include "tcp_internal.h"
 #include "net_stats.h"
 
@@ -116,6 +117,8 @@ static enum test_case_no {
 	TEST_CLIENT_SEQ_VALIDATION = 19,
 	TEST_SERVER_ACK_VALIDATION = 20,
 	TEST_SERVER_FIN_ACK_AFTER_DATA = 21,
+	TEST_SERVER_SACK_TIMESTAMPS = 22,
+	TEST_GSO_SEGMENTS = 23,
 } test_case_no;
 
 static enum test_state t_state;
@@ -143,6 +146,10 @@ static void handle_client_fin_ack_with_data_test(net_sa_family_t af, struct tcph
 static void handle_client_seq_validation_test(net_sa_family_t af, struct tcphdr *th);
 static void handle_server_ack_validation_test(struct net_pkt *pkt);
 static void handle_server_fin_ack_after_data_test(net_sa_family_t af, struct tcphdr *th);
+static void handle_server_sack_timestamps_test(struct net_pkt *pkt);
+#if defined(CONFIG_NET_TCP_GSO)
+static int handle_gso_segment(struct net_pkt *pkt, struct tcphdr *th);
+#endif
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -496,6 +503,13 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_FIN_ACK_AFTER_DATA:
 		handle_server_fin_ack_after_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_SERVER_SACK_TIMESTAMPS:
+		handle_server_sack_timestamps_test(pkt);
+		break;
+#if defined(CONFIG_NET_TCP_GSO)
+	case TEST_GSO_SEGMENTS:
+		return handle_gso_segment(pkt, &th);
+#endif
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -3207,4 +3221,368 @@ ZTEST(net_tcp, test_server_fin_ack_after_data)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+static uint32_t sack_ts_ack;
+static uint32_t sack_ts_tsecr;
+static uint32_t sack_ts_left;
+static uint32_t sack_ts_right;
+static bool sack_ts_sack_found;
+static bool sack_ts_ts_found;
+
+static void handle_server_sack_timestamps_test(struct net_pkt *pkt)
+{
+	uint8_t options[NET_TCP_MAX_OPT_SIZE];
+	struct tcphdr th;
+	size_t len;
+	size_t i;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	zassert_equal(ret, 0, "Cannot read TCP header");
+	test_verify_flags(&th, ACK);
+
+	len = th.th_off * 4U - sizeof(struct tcphdr);
+	zassert_true(len <= sizeof(options), "Invalid TCP options length %zu", len);
+
+	net_pkt_set_overwrite(pkt, true);
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			   sizeof(struct tcphdr));
+	zassert_equal(ret, 0, "Cannot skip TCP header");
+	ret = net_pkt_read(pkt, options, len);
+	zassert_equal(ret, 0, "Cannot read TCP options");
+	net_pkt_cursor_init(pkt);
+
+	sack_ts_ack = net_ntohl(th.th_ack);
+	sack_ts_sack_found = false;
+	sack_ts_ts_found = false;
+
+	for (i = 0; i < len && options[i] != NET_TCP_END_OPT; ) {
+		if (options[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		zassert_true(i + 1 < len && options[i + 1] >= 2, "Invalid TCP option");
+
+		if (options[i] == NET_TCP_SACK_OPT) {
+			zassert_equal(options[i + 1], 2 + NET_TCP_SACK_BLOCK_SIZE,
+				      "Unexpected SACK option length");
+			sack_ts_left = net_ntohl(UNALIGNED_GET((uint32_t *)&options[i + 2]));
+			sack_ts_right = net_ntohl(UNALIGNED_GET((uint32_t *)&options[i + 6]));
+			sack_ts_sack_found = true;
+		} else if (options[i] == NET_TCP_TIMESTAMP_OPT) {
+			sack_ts_tsecr = net_ntohl(UNALIGNED_GET((uint32_t *)&options[i + 6]));
+			sack_ts_ts_found = true;
+		}
+
+		i += options[i + 1];
+	}
+
+	test_sem_give();
+}
+
+static void send_sack_timestamps_data(uint32_t data_seq, size_t data_len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = data_seq;
+	pkt = prepare_data_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT),
+				  lorem_ipsum, data_len);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Peer will release the semaphore after it receives the ACK */
+	test_sem_take(K_MSEC(100), __LINE__);
+}
+
+/* Test case scenario IPv4
+ *   Expect SYN with SACK permitted and timestamps options,
+ *   send SYN ACK,
+ *   expect ACK,
+ *   send out of order DATA,
+ *   expect ACK with a SACK block covering it and the timestamp echoed,
+ *   send missing DATA,
+ *   expect ACK covering all data, without SACK block.
+ */
+ZTEST(net_tcp, test_server_sack_timestamps)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	uint32_t base;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_SACK);
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_TIMESTAMPS);
+
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	t_state = T_SYN;
+	test_case_no = TEST_SERVER_WITH_OPTIONS_IPV4;
+	seq = ack = 0;
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_bind(ctx, (struct net_sockaddr *)&my_addr_s,
+			       sizeof(struct net_sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_true(accepted_ctx->tcp->sack_ok, "SACK not negotiated");
+	zassert_true(accepted_ctx->tcp->ts_ok, "Timestamps not negotiated");
+
+	/* This will force the packets to be routed to our checker func
+	 * handle_server_sack_timestamps_test()
+	 */
+	test_case_no = TEST_SERVER_SACK_TIMESTAMPS;
+	base = seq;
+
+	/* The hole is reported by the SACK block */
+	send_sack_timestamps_data(base + 10U, 10U);
+
+	zassert_equal(sack_ts_ack, base, "Unexpected ACK %u", sack_ts_ack);
+	zassert_true(sack_ts_sack_found, "No SACK block");
+	zassert_equal(sack_ts_left, base + 10U, "Unexpected SACK left edge %u", sack_ts_left);
+	zassert_equal(sack_ts_right, base + 20U, "Unexpected SACK right edge %u",
+		      sack_ts_right);
+	zassert_true(sack_ts_ts_found, "No timestamps");
+	zassert_equal(sack_ts_tsecr, 0xc27bef0f, "Unexpected TSecr %x", sack_ts_tsecr);
+
+	/* Filling the hole acknowledges everything */
+	send_sack_timestamps_data(base, 10U);
+
+	zassert_equal(sack_ts_ack, base + 20U, "Unexpected ACK %u", sack_ts_ack);
+	zassert_false(sack_ts_sack_found, "Unexpected SACK block");
+	zassert_true(sack_ts_ts_found, "No timestamps");
+
+	/* Just send a RST packet to abort the underlying connection, so that
+	 * the testcase does not need to implement full TCP closing handshake.
+	 */
+	seq = base + 20U;
+	rst = prepare_rst_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT));
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_VEGAS)
+/* Bottleneck of the simulated path, in segments and milliseconds */
+#define VEGAS_TEST_BDP 10U
+#define VEGAS_TEST_BASE_RTT 100U
+
+/* Acknowledge one window of full segments, the sender keeping the window
+ * full. Each segment queued beyond the bandwidth-delay product of the path
+ * adds its transmission time to the RTT, which is measured on the first
+ * segment only, as done by the stack.
+ */
+static void vegas_ack_window(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+	uint32_t segs = conn->ca.cwnd / mss;
+	uint32_t rtt = VEGAS_TEST_BASE_RTT;
+
+	if (segs > VEGAS_TEST_BDP) {
+		rtt += (segs - VEGAS_TEST_BDP) * (VEGAS_TEST_BASE_RTT / VEGAS_TEST_BDP);
+	}
+
+	for (uint32_t i = 0U; i < segs; i++) {
+		conn->unacked_len = conn->ca.cwnd;
+		conn->ca.ops->pkts_acked(conn, mss, i == 0U ? rtt : 0U);
+		conn->seq += mss;
+	}
+}
+
+ZTEST(net_tcp, test_vegas_queueing_delay)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t mss;
+	uint16_t cwnd;
+	int ret;
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_set_iface(ctx, net_iface);
+
+	conn = ctx->tcp;
+	mss = conn_mss(conn);
+	conn->ca.ops = tcp_ca_find("vegas", sizeof("vegas"));
+	zassert_not_null(conn->ca.ops, "Vegas not found");
+	conn->ca.ops->init(conn);
+
+	for (int i = 0; i < 30; i++) {
+		vegas_ack_window(conn);
+	}
+
+	/* The window settles between alpha and beta segments above the BDP */
+	cwnd = conn->ca.cwnd;
+	zassert_true(cwnd > VEGAS_TEST_BDP * mss, "Window not grown (%u)", cwnd);
+	zassert_true(cwnd <= (VEGAS_TEST_BDP + 4U) * mss, "Window too large (%u)", cwnd);
+
+	/* and stops growing as long as the queueing delay stays */
+	for (int i = 0; i < 30; i++) {
+		vegas_ack_window(conn);
+		zassert_equal(conn->ca.cwnd, cwnd, "Window changed (%u != %u)",
+			      conn->ca.cwnd, cwnd);
+	}
+
+	net_context_put(ctx);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_VEGAS */
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Three full segments and a partial one */
+#define GSO_TEST_MSS 100U
+#define GSO_TEST_DATA_LEN (3U * GSO_TEST_MSS + 50U)
+#define GSO_TEST_HDR_LEN (sizeof(struct net_ipv4_hdr) + sizeof(struct tcphdr))
+
+static uint8_t gso_data[GSO_TEST_DATA_LEN];
+static int gso_segs;
+static int gso_fail_at;
+
+static int handle_gso_segment(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t payload[GSO_TEST_MSS];
+	size_t offset = gso_segs * GSO_TEST_MSS;
+	size_t len = MIN(GSO_TEST_MSS, GSO_TEST_DATA_LEN - offset);
+	int ret;
+
+	if (gso_segs++ == gso_fail_at) {
+		return -EIO;
+	}
+
+	zassert_equal(net_pkt_gso_size(pkt), 0U, "Segment %d not split", gso_segs);
+	zassert_equal(net_pkt_get_len(pkt), GSO_TEST_HDR_LEN + len,
+		      "Segment %d length mismatch", gso_segs);
+	zassert_equal(net_ntohl(th->th_seq), seq + offset,
+		      "Segment %d seq mismatch", gso_segs);
+
+	/* Only the last segment pushes and closes */
+	if (offset + len < GSO_TEST_DATA_LEN) {
+		test_verify_flags(th, ACK);
+	} else {
+		test_verify_flags(th, PSH | FIN | ACK);
+	}
+
+	zassert_equal(net_calc_chksum_ipv4(pkt), 0U,
+		      "Segment %d IPv4 checksum mismatch", gso_segs);
+	zassert_equal(net_calc_chksum_tcp(pkt), 0U,
+		      "Segment %d TCP checksum mismatch", gso_segs);
+
+	net_pkt_cursor_init(pkt);
+	ret = net_pkt_skip(pkt, GSO_TEST_HDR_LEN);
+	if (ret == 0) {
+		ret = net_pkt_read(pkt, payload, len);
+	}
+
+	zassert_equal(ret, 0, "Cannot read segment %d", gso_segs);
+	zassert_mem_equal(payload, &gso_data[offset], len,
+			  "Segment %d data mismatch", gso_segs);
+
+	net_pkt_cursor_init(pkt);
+
+	return 0;
+}
+
+static struct net_pkt *prepare_gso_packet(void)
+{
+	struct net_pkt *pkt;
+
+	pkt = tester_prepare_tcp_pkt(NET_AF_INET, net_htons(MY_PORT),
+				     net_htons(PEER_PORT), PSH | FIN | ACK,
+				     gso_data, sizeof(gso_data));
+	zassert_not_null(pkt, "Cannot prepare packet");
+
+	net_pkt_set_gso_size(pkt, GSO_TEST_MSS);
+
+	/* Keep a reference to check who releases the packet */
+	net_pkt_ref(pkt);
+
+	return pkt;
+}
+
+/* Test case scenario IPv4
+ *   split a packet of more than one MSS on an interface without TSO,
+ *   expect each segment with its own seq, flags and checksums,
+ *   fail the send of a segment in the middle, then of the first one,
+ *   expect the packet released only if a segment was sent.
+ */
+ZTEST(net_tcp, test_gso_segments)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	zassert_false(net_eth_get_hw_capabilities(net_iface) & ETHERNET_HW_TX_TSO,
+		      "Interface segments in hardware");
+
+	for (size_t i = 0; i < sizeof(gso_data); i++) {
+		gso_data[i] = (uint8_t)i;
+	}
+
+	test_case_no = TEST_GSO_SEGMENTS;
+	seq = 1000U;
+	ack = 1U;
+
+	gso_segs = 0;
+	gso_fail_at = -1;
+	pkt = prepare_gso_packet();
+	ret = net_tcp_gso_send(net_iface, pkt);
+	zassert_equal(ret, (int)(4U * GSO_TEST_HDR_LEN + GSO_TEST_DATA_LEN),
+		      "Unexpected sent length (%d)", ret);
+	zassert_equal(gso_segs, 4, "Unexpected segment count (%d)", gso_segs);
+	zassert_equal(atomic_get(&pkt->atomic_ref), 1, "Packet not released");
+	net_pkt_unref(pkt);
+
+	/* The segments after the failure are dropped, the ones sent are
+	 * reported.
+	 */
+	gso_segs = 0;
+	gso_fail_at = 2;
+	pkt = prepare_gso_packet();
+	ret = net_tcp_gso_send(net_iface, pkt);
+	zassert_equal(ret, (int)(2U * (GSO_TEST_HDR_LEN + GSO_TEST_MSS)),
+		      "Unexpected sent length (%d)", ret);
+	zassert_equal(gso_segs, 3, "Segments sent after the failure (%d)", gso_segs);
+	zassert_equal(atomic_get(&pkt->atomic_ref), 1, "Packet not released");
+	net_pkt_unref(pkt);
+
+	/* Nothing sent, the packet stays with the caller */
+	gso_segs = 0;
+	gso_fail_at = 0;
+	pkt = prepare_gso_packet();
+	ret = net_tcp_gso_send(net_iface, pkt);
+	zassert_equal(ret, -EIO, "Unexpected error (%d)", ret);
+	zassert_equal(gso_segs, 1, "Segments sent after the failure (%d)", gso_segs);
+	zassert_equal(atomic_get(&pkt->atomic_ref), 2, "Packet released");
+	net_pkt_unref(pkt);
+	net_pkt_unref(pkt);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
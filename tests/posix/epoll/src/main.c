@@ -0,0 +1,183 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/posix/sys/epoll.h>
+#include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/ztest.h>
+
+/* More than zvfs_epoll_wait() fetches from its poll set at once */
+#define NUM_FDS 12
+
+static int epfd = -1;
+static int efds[NUM_FDS];
+
+static void add_all(void)
+{
+	struct epoll_event ev = {.events = EPOLLIN};
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		ev.data.u32 = i;
+		zassert_ok(epoll_ctl(epfd, EPOLL_CTL_ADD, efds[i], &ev), "add %d failed: %d",
+			   i, errno);
+	}
+}
+
+ZTEST(posix_epoll, test_epoll_ctl)
+{
+	struct epoll_event ev = {.events = EPOLLIN};
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_ADD, efds[0], &ev));
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, efds[0], &ev), -1);
+	zassert_equal(errno, EEXIST);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_MOD, efds[1], &ev), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_ctl(efds[1], EPOLL_CTL_ADD, efds[0], &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_DEL, efds[0], NULL));
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, efds[0], NULL), -1);
+	zassert_equal(errno, ENOENT);
+}
+
+ZTEST(posix_epoll, test_epoll_ready_only)
+{
+	struct epoll_event events[NUM_FDS];
+	eventfd_t val;
+
+	add_all();
+
+	zassert_equal(epoll_wait(epfd, events, NUM_FDS, 0), 0);
+
+	zassert_ok(eventfd_write(efds[2], 1));
+
+	zassert_equal(epoll_wait(epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].events, EPOLLIN);
+	zassert_equal(events[0].data.u32, 2);
+
+	/* Level-triggered: reported until the eventfd is drained */
+	zassert_equal(epoll_wait(epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].data.u32, 2);
+
+	zassert_ok(eventfd_read(efds[2], &val));
+	zassert_equal(epoll_wait(epfd, events, NUM_FDS, 10), 0);
+}
+
+ZTEST(posix_epoll, test_epoll_maxevents)
+{
+	struct epoll_event events[NUM_FDS];
+	uint32_t seen = 0U;
+
+	add_all();
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		zassert_ok(eventfd_write(efds[i], 1));
+	}
+
+	zassert_equal(epoll_wait(epfd, events, NUM_FDS, 0), NUM_FDS);
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		zassert_equal(events[i].events, EPOLLIN);
+		seen |= BIT(events[i].data.u32);
+	}
+
+	zassert_equal(seen, BIT_MASK(NUM_FDS), "reported %#x", seen);
+
+	zassert_equal(epoll_wait(epfd, events, 3, 0), 3);
+}
+
+ZTEST(posix_epoll, test_epoll_mod)
+{
+	struct epoll_event events[NUM_FDS];
+	struct epoll_event ev = {.events = EPOLLOUT, .data.u32 = 42};
+
+	add_all();
+
+	/* An eventfd is writable as long as its counter does not overflow */
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_MOD, efds[1], &ev));
+
+	zassert_equal(epoll_wait(epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].events, EPOLLOUT);
+	zassert_equal(events[0].data.u32, 42);
+}
+
+ZTEST(posix_epoll, test_epoll_close_removes)
+{
+	struct epoll_event events[NUM_FDS];
+
+	add_all();
+
+	zassert_ok(eventfd_write(efds[3], 1));
+	zassert_ok(close(efds[3]));
+
+	zassert_equal(epoll_wait(epfd, events, NUM_FDS, 0), 0);
+
+	efds[3] = eventfd(0, 0);
+	zassert_true(efds[3] >= 0);
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, efds[3], NULL), -1);
+	zassert_equal(errno, ENOENT);
+}
+
+static void write_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)eventfd_write(efds[1], 1);
+}
+
+static K_WORK_DELAYABLE_DEFINE(write_work, write_work_handler);
+
+ZTEST(posix_epoll, test_epoll_blocking)
+{
+	struct epoll_event events[NUM_FDS];
+
+	add_all();
+
+	k_work_schedule(&write_work, K_MSEC(20));
+
+	zassert_equal(epoll_wait(epfd, events, NUM_FDS, -1), 1);
+	zassert_equal(events[0].data.u32, 1);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed: %d", errno);
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		efds[i] = eventfd(0, 0);
+		zassert_true(efds[i] >= 0, "eventfd failed: %d", errno);
+	}
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		if (efds[i] >= 0) {
+			(void)close(efds[i]);
+			efds[i] = -1;
+		}
+	}
+
+	(void)close(epfd);
+	epfd = -1;
+}
+
+ZTEST_SUITE(posix_epoll, NULL, NULL, before, after, NULL);
@@ -0,0 +1,71 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/boot_profile.h>
+#include <zephyr/ztest.h>
+
+#define SLOW_INIT_US 2000
+
+static int boot_profile_slow_init(void)
+{
+	k_busy_wait(SLOW_INIT_US);
+
+	return -EIO;
+}
+
+SYS_INIT(boot_profile_slow_init, POST_KERNEL, 42);
+
+static const struct boot_profile_record *find_entry(const char *name)
+{
+	const struct boot_profile_record *records;
+	size_t count = boot_profile_entries_get(&records);
+
+	for (size_t i = 0; i < count; i++) {
+		if (strcmp(boot_profile_name(&records[i]), name) == 0) {
+			return &records[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Test that SYS_INIT functions are timed with their level and priority
+ */
+ZTEST(boot_profile, test_sys_init_entry)
+{
+	const struct boot_profile_record *record = find_entry("boot_profile_slow_init");
+
+	zassert_not_null(record, "SYS_INIT entry not recorded");
+	zassert_equal(record->entry->priority, 42);
+	zassert_equal(record->level, 3, "not recorded at POST_KERNEL");
+	zassert_equal(record->result, -EIO);
+	zassert_true(k_cyc_to_us_floor32(record->cycles) >= SLOW_INIT_US,
+		     "unexpected duration %u us", k_cyc_to_us_floor32(record->cycles));
+}
+
+/**
+ * @brief Test that the boot phases are timed
+ */
+ZTEST(boot_profile, test_phases)
+{
+	const struct boot_profile_record *pre_kernel =
+		boot_profile_phase_get(BOOT_PROFILE_PHASE_PRE_KERNEL);
+	const struct boot_profile_record *post_kernel =
+		boot_profile_phase_get(BOOT_PROFILE_PHASE_POST_KERNEL);
+
+	zassert_str_equal(boot_profile_name(post_kernel), "post_kernel");
+	zassert_true(k_cyc_to_us_floor32(post_kernel->cycles) >= SLOW_INIT_US,
+		     "post kernel phase does not include the POST_KERNEL init functions");
+	zassert_true(post_kernel->start - pre_kernel->start >= pre_kernel->cycles,
+		     "post kernel phase started before the end of the pre kernel phase");
+}
+
+ZTEST_SUITE(boot_profile, NULL, NULL, NULL, NULL, NULL);